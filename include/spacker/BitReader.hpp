@@ -0,0 +1,147 @@
+#ifndef SPACKER_BIT_READER_HPP
+#define SPACKER_BIT_READER_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+/**
+ * @file BitReader.hpp
+ *
+ * @brief Read arbitrary numbers of bits from a byte array.
+ */
+
+namespace spacker {
+
+/**
+ * @param x Some integer.
+ * @return Number of consecutive set bits, starting from the most significant bit.
+ */
+inline int count_leading_ones(uint64_t x) {
+    x = ~x;
+    if (x == 0) {
+        return 64;
+    }
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clzll(x);
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse64(&index, x);
+    return 63 - static_cast<int>(index);
+#else
+    int n = 0;
+    while ((x & (static_cast<uint64_t>(1) << 63)) == 0) {
+        x <<= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+/**
+ * @param ptr Pointer to at least 8 bytes.
+ * @return The 8 bytes as an integer, treating the first byte as the most significant.
+ */
+inline uint64_t load_big_endian(const uint8_t* ptr) {
+    // Compilers recognize this and emit a single load and byte swap.
+    uint64_t output = 0;
+    for (int i = 0; i < 8; ++i) {
+        output = (output << 8) | ptr[i];
+    }
+    return output;
+}
+
+/**
+ * @brief Read bits from a byte array through a 64-bit window.
+ *
+ * Bits are consumed from the most significant bit of each byte, consistent with the layout used by `pack_psip()`.
+ * The window is left-aligned, i.e., the next bit to be read is the most significant bit of `window()`.
+ */
+class BitReader {
+public:
+    /**
+     * @param n Number of bytes in the input.
+     * @param input Pointer to the input bytes.
+     * @param start Position of the first bit to read, in bits from the start of `input`.
+     */
+    BitReader(size_t n, const uint8_t* input, size_t start = 0) : origin(input), ptr(input + start / 8), end(input + n) {
+        refill();
+        skip(start % 8);
+    }
+
+    /**
+     * Fill the window so that at least 56 bits are available, if there are enough bits remaining in the input.
+     * Only whole bytes are loaded, so up to 63 bits may be available depending on the current position.
+     */
+    void refill() {
+        if (end - ptr >= 8) {
+            // Any bits past 'avail' are the same as those that would be loaded by the next refill,
+            // so it doesn't matter if we OR them in early.
+            window_ |= load_big_endian(ptr) >> avail;
+            int consumed = (63 - avail) / 8;
+            ptr += consumed;
+            avail += consumed * 8;
+        } else {
+            while (avail <= 56 && ptr != end) {
+                window_ |= static_cast<uint64_t>(*ptr) << (56 - avail);
+                ++ptr;
+                avail += 8;
+            }
+        }
+    }
+
+    /**
+     * @return Left-aligned window of bits.
+     * Only the first `available()` bits are valid; any subsequent bits are either zero or the next bits in the input.
+     */
+    uint64_t window() const {
+        return window_;
+    }
+
+    /**
+     * @return Number of valid bits in the window.
+     */
+    int available() const {
+        return avail;
+    }
+
+    /**
+     * @param n Number of bits to skip, no greater than `available()`.
+     */
+    void skip(int n) {
+        // Two shifts to avoid undefined behavior when n = 64.
+        window_ = (window_ << (n / 2)) << (n - n / 2);
+        avail -= n;
+    }
+
+    /**
+     * @param n Number of bits to read, no greater than `available()` or 63.
+     * @return The next `n` bits, as an integer.
+     */
+    uint64_t read(int n) {
+        uint64_t output = (window_ >> 1) >> (63 - n);
+        skip(n);
+        return output;
+    }
+
+    /**
+     * @return Number of bits that have been consumed from the start of the input.
+     */
+    size_t position() const {
+        return static_cast<size_t>(ptr - origin) * 8 - avail;
+    }
+
+private:
+    const uint8_t* origin;
+    const uint8_t* ptr;
+    const uint8_t* end;
+    uint64_t window_ = 0;
+    int avail = 0;
+};
+
+}
+
+#endif
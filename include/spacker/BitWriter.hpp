@@ -0,0 +1,142 @@
+#ifndef SPACKER_BIT_WRITER_HPP
+#define SPACKER_BIT_WRITER_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @file BitWriter.hpp
+ *
+ * @brief Write arbitrary numbers of bits to a byte container.
+ */
+
+namespace spacker {
+
+/**
+ * @param val Some integer.
+ * @param ptr Pointer to at least 8 bytes, to be filled with `val` such that the first byte is the most significant.
+ */
+inline void store_big_endian(uint64_t val, uint8_t* ptr) {
+    // Compilers recognize this and emit a single byte swap and store.
+    for (int i = 7; i >= 0; --i) {
+        ptr[i] = static_cast<uint8_t>(val);
+        val >>= 8;
+    }
+}
+
+/**
+ * @tparam Output Container of bytes that supports `push_back()`.
+ * @param word Word to be appended.
+ * @param output Container to which the 8 bytes of `word` are appended, starting from the most significant byte.
+ *
+ * Overloads are provided for `std::vector` and `RawOutput` to append all bytes with a single store.
+ */
+template<class Output>
+void append_word(uint64_t word, Output& output) {
+    for (int shift = 56; shift >= 0; shift -= 8) {
+        output.push_back(static_cast<uint8_t>(word >> shift));
+    }
+}
+
+/**
+ * @tparam Allocator Allocator for the vector.
+ * @param word Word to be appended.
+ * @param output Vector to which the 8 bytes of `word` are appended, starting from the most significant byte.
+ */
+template<class Allocator>
+void append_word(uint64_t word, std::vector<uint8_t, Allocator>& output) {
+    // Inserting a range avoids the zero-initialization of resize().
+    uint8_t buffer[8];
+    store_big_endian(word, buffer);
+    output.insert(output.end(), buffer, buffer + 8);
+}
+
+/**
+ * @brief Write bits to a byte container through a 64-bit accumulator.
+ *
+ * Bits are written from the most significant bit of each byte, consistent with the layout expected by `unpack_psip()`.
+ * Completed 64-bit words are appended to the output with a single store where possible, rather than one byte at a time.
+ * The output container is passed to each call so that the writer itself is trivially copyable.
+ */
+class BitWriter {
+public:
+    /**
+     * @tparam Output Container of bytes that supports `push_back()`.
+     * @param bits Bits to be written, right-aligned in the integer.
+     * Any bits above the lowest `n` should be zero.
+     * @param n Number of bits to write, from 0 to 64.
+     * @param output Container to which completed words are appended.
+     */
+    template<class Output>
+    void write(uint64_t bits, int n, Output& output) {
+        int space = 64 - used;
+        if (n < space) {
+            accumulator = (accumulator << n) | bits; // n < 64 here, so the shift is always valid.
+            used += n;
+            return;
+        }
+
+        // Filling up the accumulator and flushing it; 'space' is never zero as 'used' is always less than 64.
+        int overflow = n - space;
+        uint64_t full = (space == 64 ? bits : (accumulator << space) | (bits >> overflow));
+        append_word(full, output);
+        accumulator = (overflow ? bits & ((static_cast<uint64_t>(1) << overflow) - 1) : 0);
+        used = overflow;
+    }
+
+    /**
+     * @tparam Output Container of bytes that supports `push_back()`.
+     * @param output Container to which completed words are appended.
+     *
+     * Pad the current byte with ones until the next byte boundary.
+     */
+    template<class Output>
+    void pad_with_ones(Output& output) {
+        int pad = padding();
+        if (pad) {
+            write((static_cast<uint64_t>(1) << pad) - 1, pad, output);
+        }
+    }
+
+    /**
+     * @tparam Output Container of bytes that supports `push_back()`.
+     * @param output Container to which all remaining bytes are appended.
+     *
+     * Pad the current byte with zeros and write all bytes in the accumulator.
+     * The writer is then reset so that it can be used for another stream.
+     */
+    template<class Output>
+    void finish(Output& output) {
+        int pad = padding();
+        accumulator <<= pad;
+        used += pad;
+        for (int shift = used - 8; shift >= 0; shift -= 8) {
+            output.push_back(static_cast<uint8_t>(accumulator >> shift));
+        }
+        accumulator = 0;
+        used = 0;
+    }
+
+    /**
+     * @return Number of bits that have not yet been appended to the output.
+     */
+    int pending() const {
+        return used;
+    }
+
+    /**
+     * @return Number of bits required to reach the next byte boundary.
+     */
+    int padding() const {
+        return (8 - used % 8) % 8;
+    }
+
+private:
+    uint64_t accumulator = 0;
+    int used = 0;
+};
+
+}
+
+#endif
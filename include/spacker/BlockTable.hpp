@@ -0,0 +1,124 @@
+#ifndef SPACKER_BLOCK_TABLE_HPP
+#define SPACKER_BLOCK_TABLE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <stdexcept>
+
+/**
+ * @file BlockTable.hpp
+ *
+ * @brief Header table for block-structured streams.
+ */
+
+namespace spacker {
+
+/**
+ * @brief Layout of a block-structured stream.
+ *
+ * A block-structured stream contains a header followed by the concatenation of independently packed blocks.
+ * The header consists of the number of blocks, followed by the number of bytes and the number of integers in each block.
+ * All header fields are stored as 64-bit little-endian unsigned integers.
+ *
+ * The header is always present, even for a single block, so a block-structured stream is never interchangeable with the output of `pack_psip()`.
+ * Instead, the bytes of each block are identical to those from `pack_psip()` on the block's integers.
+ */
+struct BlockTable {
+    /**
+     * Byte offset of the start of each block, relative to the start of the stream.
+     * This has one more entry than the number of blocks, with the last entry containing the total length of the stream.
+     */
+    std::vector<size_t> offsets;
+
+    /**
+     * Position of the first integer of each block in the unpacked stream.
+     * This has one more entry than the number of blocks, with the last entry containing the total number of integers.
+     */
+    std::vector<size_t> starts;
+
+    /**
+     * @return Number of blocks.
+     */
+    size_t size() const {
+        return (offsets.empty() ? 0 : offsets.size() - 1);
+    }
+};
+
+/**
+ * @param nblocks Number of blocks.
+ * @return Number of bytes in the header.
+ */
+inline size_t block_header_size(size_t nblocks) {
+    return 8 * (1 + 2 * nblocks);
+}
+
+inline void write_uint64_le(uint64_t val, uint8_t* output) {
+    for (int i = 0; i < 8; ++i) {
+        output[i] = static_cast<uint8_t>(val >> (8 * i));
+    }
+}
+
+inline uint64_t read_uint64_le(const uint8_t* input) {
+    uint64_t output = 0;
+    for (int i = 7; i >= 0; --i) {
+        output = (output << 8) | input[i];
+    }
+    return output;
+}
+
+/**
+ * @param nbytes Number of bytes in each block.
+ * @param nints Number of integers in each block.
+ * @param output Pointer to an array of length `block_header_size(nbytes.size())`, to store the header.
+ */
+inline void write_block_header(const std::vector<size_t>& nbytes, const std::vector<size_t>& nints, uint8_t* output) {
+    write_uint64_le(nbytes.size(), output);
+    output += 8;
+    for (size_t b = 0; b < nbytes.size(); ++b) {
+        write_uint64_le(nbytes[b], output);
+        write_uint64_le(nints[b], output + 8);
+        output += 16;
+    }
+}
+
+/**
+ * @param ni Number of bytes in the stream.
+ * @param input Pointer to a block-structured stream.
+ * @return Layout of the stream.
+ * An error is thrown if the header is inconsistent with `ni`.
+ */
+inline BlockTable read_block_header(size_t ni, const uint8_t* input) {
+    if (ni < 8) {
+        throw std::runtime_error("block-structured stream is too short for its header");
+    }
+    size_t nblocks = read_uint64_le(input);
+    if (nblocks > (ni - 8) / 16) {
+        throw std::runtime_error("block-structured stream is too short for its header");
+    }
+
+    BlockTable output;
+    output.offsets.reserve(nblocks + 1);
+    output.starts.reserve(nblocks + 1);
+    size_t offset = block_header_size(nblocks), start = 0;
+
+    const uint8_t* ptr = input + 8;
+    for (size_t b = 0; b < nblocks; ++b, ptr += 16) {
+        output.offsets.push_back(offset);
+        output.starts.push_back(start);
+        offset += read_uint64_le(ptr);
+        start += read_uint64_le(ptr + 8);
+    }
+
+    output.offsets.push_back(offset);
+    output.starts.push_back(start);
+    if (offset > ni) {
+        throw std::runtime_error("block-structured stream is shorter than the sum of its blocks");
+    }
+
+    return output;
+}
+
+}
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef SPACKER_DECODE_STATS_HPP
+#define SPACKER_DECODE_STATS_HPP
+
+#include <cstddef>
+
+/**
+ * @file DecodeStats.hpp
+ *
+ * @brief Per-byte counters for the decoder.
+ *
+ * Counting is only performed if `SPACKER_DECODE_STATS` is defined, otherwise the counters are compiled away.
+ * This macro should be defined consistently across all translation units that include the **spacker** headers.
+ */
+
+namespace spacker {
+
+/**
+ * @brief Counts of the paths taken by the decoder for each input byte.
+ *
+ * This is useful for identifying the cost of decoding a stream, e.g., a high proportion of table bytes is slower than short-code bytes.
+ */
+struct DecodeStats {
+    /**
+     * Number of bytes that were entirely payload of a multi-byte code.
+     */
+    size_t payload_bytes = 0;
+
+    /**
+     * Number of bytes that were decoded with a lookup into the `TransitionTable`.
+     */
+    size_t table_bytes = 0;
+
+    /**
+     * Number of RLE marker bytes.
+     */
+    size_t rle_marker_bytes = 0;
+
+    /**
+     * Number of bytes decoded by the fast path for 1- and 2-bit codes under `Doubling<1>`.
+     */
+    size_t short_code_bytes = 0;
+};
+
+#ifdef SPACKER_DECODE_STATS
+/**
+ * @return Counters for the current thread, which can be reset by assigning a default-constructed `DecodeStats`.
+ * Only available if `SPACKER_DECODE_STATS` is defined.
+ */
+inline DecodeStats& decode_stats() {
+    thread_local DecodeStats stats;
+    return stats;
+}
+
+#define SPACKER_DECODE_COUNT(field, n) (::spacker::decode_stats().field += (n))
+#else
+#define SPACKER_DECODE_COUNT(field, n)
+#endif
+
+}
+
+#endif
@@ -35,13 +35,6 @@ struct Doubling {
             }
         }
     }
-
-    // Methods for unpacking.
-    static void update_remaining(int& remaining, int has_bit) {
-        remaining <<= has_bit;
-    }
-
-    static constexpr int init_remaining = base;
 };
 
 }
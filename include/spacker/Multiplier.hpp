@@ -35,13 +35,6 @@ struct Multiplier {
             }
         }
     }
-
-    // Methods for unpacking.
-    static void update_remaining(int& remaining, int has_bit) {
-        remaining += factor * has_bit;
-    }
-
-    static constexpr int init_remaining = factor;
 };
 
 }
@@ -0,0 +1,54 @@
+#ifndef SPACKER_OFFSET_HPP
+#define SPACKER_OFFSET_HPP
+
+#include <cstdint>
+
+/**
+ * @file Offset.hpp
+ *
+ * @brief Shift integers into the positive range.
+ */
+
+namespace spacker {
+
+/**
+ * @brief Offset transform for integers with a known lower bound.
+ *
+ * @tparam T Integer type.
+ *
+ * Each integer `x` is mapped to the code `x - offset + 1`, so the lower bound itself becomes 1.
+ * This is useful for data that contains zeros, or for signed data that is mostly positive.
+ */
+template<typename T>
+struct Offset {
+    /**
+     * @param offset Lower bound on all integers to be packed.
+     */
+    Offset(T offset = 0) : offset(offset) {}
+
+    /**
+     * Lower bound on all integers to be packed.
+     */
+    T offset;
+
+    /**
+     * @param x Integer to be packed, no less than `offset`.
+     * @return Positive code for `x`.
+     */
+    uint64_t forward(T x) const {
+        // Casting signed integers sign-extends them, so the modular arithmetic is correct.
+        return static_cast<uint64_t>(x) - static_cast<uint64_t>(offset) + 1;
+    }
+
+    /**
+     * @param code Positive code from `forward()`.
+     * @return The original integer.
+     */
+    T reverse(uint64_t code) const {
+        return static_cast<T>(code - 1 + static_cast<uint64_t>(offset));
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,118 @@
+#ifndef SPACKER_PACK_STATS_HPP
+#define SPACKER_PACK_STATS_HPP
+
+#include <cstddef>
+#include <array>
+
+/**
+ * @file PackStats.hpp
+ *
+ * @brief Statistics on the decisions made by the packer.
+ */
+
+namespace spacker {
+
+/**
+ * @brief Statistics collected while packing.
+ *
+ * This can be passed to `pack_psip()` to understand why a stream compresses poorly,
+ * e.g., too many multi-byte codes suggests that a different `Scheme` or a remapping like `pack_psip_ranked()` is needed.
+ * Counts are added to any existing values, so a single instance can summarize multiple streams.
+ */
+struct PackStats {
+    /**
+     * Number of literal codes with each number of preamble bits.
+     * RLE lengths are not included.
+     */
+    std::array<size_t, 8> classes{};
+
+    /**
+     * Total number of bits in literal codes.
+     */
+    size_t literal_bits = 0;
+
+    /**
+     * Number of literal codes that are wider than a byte.
+     */
+    size_t multi_byte_codes = 0;
+
+    /**
+     * Number of runs that were run-length encoded.
+     */
+    size_t rle_taken = 0;
+
+    /**
+     * Number of runs of two or more integers that were not run-length encoded, based on the approximate cost check.
+     */
+    size_t rle_rejected_approximate = 0;
+
+    /**
+     * Number of runs of two or more integers that passed the approximate cost check but were not run-length encoded, based on the exact cost check.
+     */
+    size_t rle_rejected_exact = 0;
+
+    /**
+     * Number of bits spent on padding before each RLE marker.
+     */
+    size_t rle_padding_bits = 0;
+
+    /**
+     * @return Proportion of literal codes that are wider than a byte.
+     */
+    double multi_byte_share() const {
+        size_t total = 0;
+        for (auto c : classes) {
+            total += c;
+        }
+        return (total ? static_cast<double>(multi_byte_codes) / total : 0);
+    }
+
+    /**
+     * @param bits Number of preamble bits.
+     * @param width Width of the code.
+     * @param count Number of copies of the code.
+     */
+    void add_literals(int bits, int width, size_t count) {
+        classes[bits] += count;
+        literal_bits += static_cast<size_t>(width) * count;
+        if (width > 8) {
+            multi_byte_codes += count;
+        }
+    }
+
+    /**
+     * @param padding Number of padding bits before the RLE marker.
+     */
+    void add_rle(int padding) {
+        ++rle_taken;
+        rle_padding_bits += padding;
+    }
+
+    /**
+     * @param exact Whether the run was rejected by the exact cost check.
+     */
+    void add_rejected(bool exact) {
+        if (exact) {
+            ++rle_rejected_exact;
+        } else {
+            ++rle_rejected_approximate;
+        }
+    }
+};
+
+/**
+ * @brief Placeholder for when no statistics are to be collected.
+ *
+ * This has the same interface as `PackStats` but does nothing, so that all statistics collection is compiled away.
+ */
+struct NoStats {
+    void add_literals(int, int, size_t) {}
+
+    void add_rle(int) {}
+
+    void add_rejected(bool) {}
+};
+
+}
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef SPACKER_PSIP_ARENA_HPP
+#define SPACKER_PSIP_ARENA_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include "Doubling.hpp"
+#include "pack_psip.hpp"
+
+/**
+ * @file PsipArena.hpp
+ *
+ * @brief Pack many short vectors into one contiguous buffer.
+ */
+
+namespace spacker {
+
+/**
+ * @brief Pack many vectors of positive small integers back-to-back.
+ *
+ * @tparam rle Whether to use run-length encoding.
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam Output Container of bytes, supporting `push_back()`, `reserve()`, `size()`, `data()` and `clear()`.
+ *
+ * Each call to `add()` appends the packed bytes of one vector to a shared buffer and records its starting offset.
+ * This avoids a separate allocation for each vector, which is useful when packing many short vectors, e.g., the columns of a sparse matrix.
+ * The bytes for each vector are identical to those returned by `pack_psip()`, so they can be unpacked with any of the usual functions.
+ */
+template<bool rle = true, class Scheme = Doubling<>, class Output = std::vector<uint8_t> >
+class PsipArena {
+public:
+    /**
+     * @param nbytes Expected total number of packed bytes, e.g., the sum of `packed_size()` for all vectors.
+     * @param nvectors Expected number of vectors.
+     */
+    PsipArena(size_t nbytes = 0, size_t nvectors = 0) : offsets_(1, 0) {
+        reserve(nbytes, nvectors);
+    }
+
+    /**
+     * @param nbytes Expected total number of packed bytes.
+     * @param nvectors Expected number of vectors.
+     */
+    void reserve(size_t nbytes, size_t nvectors) {
+        buffer.reserve(nbytes);
+        offsets_.reserve(nvectors + 1);
+    }
+
+    /**
+     * @tparam T Type of the integers to be packed.
+     * @param n Number of integers to be packed.
+     * @param input Pointer to an array of length `n`, containing the integers to be packed.
+     * @return Index of the newly added vector.
+     */
+    template<typename T>
+    size_t add(size_t n, const T* input) {
+        pack_psip_append<rle, Scheme>(n, input, buffer);
+        offsets_.push_back(buffer.size());
+        return offsets_.size() - 2;
+    }
+
+    /**
+     * @return Number of vectors that have been added.
+     */
+    size_t size() const {
+        return offsets_.size() - 1;
+    }
+
+    /**
+     * @return Buffer containing the packed bytes for all vectors.
+     */
+    const Output& data() const {
+        return buffer;
+    }
+
+    /**
+     * @return Offsets of the packed bytes for each vector in `data()`.
+     * This has length equal to `size() + 1`, where the bytes for vector `i` lie in `[offsets()[i], offsets()[i + 1])`.
+     */
+    const std::vector<size_t>& offsets() const {
+        return offsets_;
+    }
+
+    /**
+     * @param i Index of the vector.
+     * @return Pointer to the packed bytes for vector `i`.
+     * This is invalidated by subsequent calls to `add()`.
+     */
+    const uint8_t* start(size_t i) const {
+        return buffer.data() + offsets_[i];
+    }
+
+    /**
+     * @param i Index of the vector.
+     * @return Number of packed bytes for vector `i`.
+     */
+    size_t length(size_t i) const {
+        return offsets_[i + 1] - offsets_[i];
+    }
+
+    /**
+     * Remove all vectors, keeping the allocated memory for reuse.
+     */
+    void clear() {
+        buffer.clear();
+        offsets_.resize(1);
+    }
+
+private:
+    Output buffer;
+    std::vector<size_t> offsets_;
+};
+
+}
+
+#endif
@@ -0,0 +1,158 @@
+#ifndef SPACKER_PSIP_DECODER_HPP
+#define SPACKER_PSIP_DECODER_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+#include "Doubling.hpp"
+#include "unpack_psip.hpp"
+
+/**
+ * @file PsipDecoder.hpp
+ *
+ * @brief Streaming version of the positive small integer unpacker.
+ */
+
+namespace spacker {
+
+/**
+ * @brief Unpack positive small integers from chunks of packed input.
+ *
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam T Type of the unpacked integers.
+ *
+ * Packed bytes are supplied in any number of `feed()` calls, and the unpacked integers are retrieved with `read()`.
+ * The decoding state is preserved between calls, so codes (including RLE markers and lengths) can be split across chunks.
+ * RLE runs are not expanded until they are read, so memory usage depends only on the chunk size, not on the length of the packed stream.
+ */
+template<class Scheme = Doubling<>, typename T = uint32_t>
+class PsipDecoder {
+public:
+    /**
+     * @param total Total number of integers in the packed stream.
+     * This is used to discard the padding at the end of the stream, and can be omitted if the caller knows when to stop reading.
+     */
+    PsipDecoder(size_t total = std::numeric_limits<size_t>::max()) : limit(total) {}
+
+    /**
+     * @param n Number of bytes in the chunk.
+     * @param input Pointer to the next chunk of packed bytes.
+     * This does not need to remain valid after this call.
+     *
+     * @return Number of integers that are ready to be read.
+     */
+    size_t feed(size_t n, const uint8_t* input) {
+        compact();
+
+        auto value = [&](T val) -> void {
+            if (limit) {
+                values.push_back(val);
+                --limit;
+                ++ready;
+            }
+        };
+
+        auto repeat = [&](size_t extra) -> void {
+            extra = std::min(extra, limit);
+            limit -= extra;
+            ready += extra;
+            if (vhead < values.size()) {
+                repeats.emplace_back(values.size() - 1, extra);
+            } else {
+                // Last value has already been read, so we just add more copies of it.
+                copies += extra;
+            }
+        };
+
+        for (size_t i = 0; i < n && limit; ++i) {
+            decoder.consume(input[i], value, repeat);
+        }
+
+        return ready;
+    }
+
+    /**
+     * @return Number of integers that are ready to be read.
+     */
+    size_t available() const {
+        return ready;
+    }
+
+    /**
+     * @param n Maximum number of integers to read.
+     * @param output Pointer to an array of length `n`, to store the unpacked integers.
+     *
+     * @return Number of integers that were read into `output`.
+     * This is equal to the lesser of `n` and `available()`.
+     */
+    size_t read(size_t n, T* output) {
+        size_t done = 0;
+
+        while (done < n) {
+            if (copies) {
+                size_t take = std::min(copies, n - done);
+                std::fill_n(output + done, take, last);
+                copies -= take;
+                done += take;
+                continue;
+            }
+
+            if (vhead == values.size()) {
+                break;
+            }
+
+            bool has_repeat = rhead < repeats.size();
+            size_t stop = (has_repeat ? repeats[rhead].first + 1 : values.size());
+            size_t take = std::min(stop - vhead, n - done);
+            std::copy_n(values.data() + vhead, take, output + done);
+            vhead += take;
+            done += take;
+            last = values[vhead - 1];
+
+            if (has_repeat && vhead == stop) {
+                copies = repeats[rhead].second;
+                ++rhead;
+            }
+        }
+
+        ready -= done;
+        return done;
+    }
+
+private:
+    void compact() {
+        if (vhead) {
+            values.erase(values.begin(), values.begin() + vhead);
+            repeats.erase(repeats.begin(), repeats.begin() + rhead);
+            for (auto& r : repeats) {
+                r.first -= vhead;
+            }
+            vhead = 0;
+            rhead = 0;
+        }
+    }
+
+    ByteDecoder<Scheme, T> decoder;
+    size_t limit;
+    size_t ready = 0;
+
+    // Decoded integers that have not yet been read, starting from 'vhead'.
+    std::vector<T> values;
+    size_t vhead = 0;
+
+    // RLE runs that have not yet been expanded, starting from 'rhead'.
+    // Each entry contains the index of the repeated value in 'values' and the number of extra copies.
+    std::vector<std::pair<size_t, size_t> > repeats;
+    size_t rhead = 0;
+
+    // Extra copies of the last value to be read.
+    size_t copies = 0;
+    T last = 0;
+};
+
+}
+
+#endif
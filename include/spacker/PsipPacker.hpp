@@ -0,0 +1,153 @@
+#ifndef SPACKER_PSIP_PACKER_HPP
+#define SPACKER_PSIP_PACKER_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <functional>
+#include <algorithm>
+
+#include "Doubling.hpp"
+#include "pack_psip.hpp"
+#include "simd.hpp"
+
+/**
+ * @file PsipPacker.hpp
+ *
+ * @brief Streaming version of the positive small integer packer.
+ */
+
+namespace spacker {
+
+/**
+ * @brief Pack positive small integers as they become available.
+ *
+ * @tparam rle Whether to use run-length encoding.
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam T Type of the integers to be packed.
+ *
+ * Integers are supplied in any number of `push()` calls, and the packed bytes are passed to a sink in chunks of bounded size.
+ * After `flush()`, the concatenation of all chunks is identical to the output of `pack_psip()` on the concatenation of all pushed integers.
+ * Runs of identical integers that cross `push()` boundaries are handled correctly.
+ */
+template<bool rle = true, class Scheme = Doubling<>, typename T = uint32_t>
+class PsipPacker {
+public:
+    /**
+     * @param sink Function to be called with a pointer to packed bytes and the number of bytes.
+     * The pointer is only valid for the duration of the call.
+     * @param chunk_size Maximum number of bytes to pass to `sink` in each call.
+     */
+    PsipPacker(std::function<void(const uint8_t*, size_t)> sink, size_t chunk_size = 65536) : sink(std::move(sink)), chunk_size(std::max(chunk_size, static_cast<size_t>(1))) {
+        output.reserve(this->chunk_size + 64);
+    }
+
+    /**
+     * @param val Integer to be packed.
+     */
+    void push(T val) {
+        if constexpr(rle) {
+            if (run_length && val == run_value) {
+                ++run_length;
+                return;
+            }
+            pack_run();
+            run_value = val;
+            run_length = 1;
+        } else {
+            pack_psip_inner<Scheme>(val, writer, output);
+            drain(false);
+        }
+    }
+
+    /**
+     * @param n Number of integers to be packed.
+     * @param input Pointer to an array of length `n`, containing the integers to be packed.
+     */
+    void push(size_t n, const T* input) {
+        size_t i = 0;
+
+        if constexpr(rle) {
+            // Extending the run from the previous push, if possible.
+            if (run_length) {
+                while (i < n && input[i] == run_value) {
+                    ++i;
+                }
+                run_length += i;
+                if (i == n) {
+                    return;
+                }
+                pack_run();
+            }
+
+            // All runs except the last are complete.
+            while (i < n) {
+                auto val = input[i];
+                auto copy = i + count_run(n - i, input + i);
+                run_value = val;
+                run_length = copy - i;
+                if (copy != n) {
+                    pack_run();
+                }
+                i = copy;
+            }
+
+        } else {
+            for (; i < n; ++i) {
+                pack_psip_inner<Scheme>(input[i], writer, output);
+                drain(false);
+            }
+        }
+    }
+
+    /**
+     * Pack all remaining integers and pass all remaining bytes to the sink.
+     * This finishes the current stream; subsequent `push()` calls will start a new stream.
+     */
+    void flush() {
+        pack_run();
+        pack_psip_finish(writer, output);
+        drain(true);
+    }
+
+private:
+    void pack_run() {
+        if (run_length) {
+            pack_psip_run<rle, Scheme>(run_value, run_length, writer, output);
+            run_length = 0;
+            drain(false);
+        }
+    }
+
+    void drain(bool all) {
+        if (output.size() < chunk_size && !all) {
+            return;
+        }
+
+        size_t start = 0;
+        while (output.size() - start >= chunk_size) {
+            sink(output.data() + start, chunk_size);
+            start += chunk_size;
+        }
+
+        if (all && start < output.size()) {
+            sink(output.data() + start, output.size() - start);
+            start = output.size();
+        }
+
+        output.erase(output.begin(), output.begin() + start);
+    }
+
+    std::function<void(const uint8_t*, size_t)> sink;
+    size_t chunk_size;
+    std::vector<uint8_t> output;
+
+    BitWriter writer;
+
+    T run_value = 0;
+    size_t run_length = 0;
+};
+
+}
+
+#endif
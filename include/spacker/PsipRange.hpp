@@ -0,0 +1,227 @@
+#ifndef SPACKER_PSIP_RANGE_HPP
+#define SPACKER_PSIP_RANGE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <iterator>
+#include <algorithm>
+
+#include "Doubling.hpp"
+#include "unpack_psip.hpp"
+
+/**
+ * @file PsipRange.hpp
+ *
+ * @brief Lazily iterate over packed integers.
+ */
+
+namespace spacker {
+
+/**
+ * @brief Range of packed integers that are decoded on the fly.
+ *
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam T Type of the unpacked integers.
+ *
+ * Iterating over this range decodes one byte at a time into a small internal window,
+ * so no array of unpacked integers is ever allocated.
+ * RLE runs are stored in the window as a value and a length, and are not expanded in memory.
+ * This can be used in range-based `for` loops or with standard algorithms like `std::transform_reduce()`.
+ */
+template<class Scheme = Doubling<>, typename T = uint32_t>
+class PsipRange {
+public:
+    /**
+     * @param ni Number of bytes in the packed input.
+     * @param input Pointer to the packed input, created by `pack_psip()`.
+     * This should remain valid for the lifetime of the range and its iterators.
+     * @param no Number of integers in the packed input.
+     */
+    PsipRange(size_t ni, const uint8_t* input, size_t no) : ni(ni), input(input), no(no) {}
+
+    /**
+     * @brief Input iterator over the unpacked integers.
+     */
+    class iterator {
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const T* pointer;
+        typedef const T& reference;
+
+        /**
+         * Construct an iterator that is equal to `PsipRange::end()`.
+         */
+        iterator() = default;
+
+        /**
+         * @param ni Number of bytes in the packed input.
+         * @param input Pointer to the packed input.
+         * @param no Number of integers in the packed input.
+         *
+         * This is typically called by `PsipRange::begin()` rather than by users.
+         */
+        iterator(size_t ni, const uint8_t* input, size_t no) : ni(ni), input(input), left(no) {
+            if (left) {
+                next_run();
+            }
+        }
+
+        /**
+         * @return The current integer.
+         */
+        const T& operator*() const {
+            return current;
+        }
+
+        /**
+         * @return Pointer to the current integer.
+         */
+        const T* operator->() const {
+            return &current;
+        }
+
+        /**
+         * @return This iterator, advanced to the next integer.
+         */
+        iterator& operator++() {
+            --left;
+            --copies;
+            if (left && copies == 0) {
+                next_run();
+            }
+            return *this;
+        }
+
+        /**
+         * @return Copy of this iterator before it was advanced to the next integer.
+         */
+        iterator operator++(int) {
+            auto copy = *this;
+            ++(*this);
+            return copy;
+        }
+
+        /**
+         * @return Number of integers, including the current one, that are equal to the current integer in the current run.
+         * This may be greater than 1 for RLE runs, allowing callers to process the entire run at once.
+         */
+        size_t run_length() const {
+            return std::min(copies, left);
+        }
+
+        /**
+         * @return This iterator, advanced past all integers in the current run.
+         * This is equivalent to calling `operator++()` `run_length()` times.
+         */
+        iterator& skip_run() {
+            left -= run_length();
+            copies = 0;
+            if (left) {
+                next_run();
+            }
+            return *this;
+        }
+
+        /**
+         * @param other Another iterator over the same range.
+         * @return Whether the two iterators have the same number of integers remaining.
+         */
+        bool operator==(const iterator& other) const {
+            return left == other.left;
+        }
+
+        /**
+         * @param other Another iterator over the same range.
+         * @return Whether the two iterators have different numbers of integers remaining.
+         */
+        bool operator!=(const iterator& other) const {
+            return left != other.left;
+        }
+
+    private:
+        void next_run() {
+            if (whead == wsize) {
+                fill();
+                if (wsize == 0) {
+                    left = 0; // stream ended prematurely.
+                    return;
+                }
+            }
+            current = window[whead].first;
+            copies = window[whead].second;
+            ++whead;
+        }
+
+        void fill() {
+            whead = 0;
+            wsize = 0;
+
+            auto value = [&](T val) -> void {
+                window[wsize] = std::make_pair(val, static_cast<size_t>(1));
+                ++wsize;
+                last = val;
+            };
+
+            auto repeat = [&](size_t extra) -> void {
+                if (extra) {
+                    window[wsize] = std::make_pair(last, extra);
+                    ++wsize;
+                }
+            };
+
+            while (wsize == 0 && i < ni) {
+                decoder.consume(input[i], value, repeat);
+                ++i;
+            }
+        }
+
+        size_t ni = 0;
+        const uint8_t* input = NULL;
+        size_t i = 0;
+        ByteDecoder<Scheme, T> decoder;
+
+        // Runs decoded from the last byte, starting from 'whead'.
+        // A byte contains at most 8 codes, one of which might be an RLE length.
+        std::array<std::pair<T, size_t>, 8> window;
+        int whead = 0;
+        int wsize = 0;
+        T last = 0;
+
+        size_t left = 0;
+        T current = 0;
+        size_t copies = 0;
+    };
+
+    /**
+     * @return Iterator to the first integer.
+     */
+    iterator begin() const {
+        return iterator(ni, input, no);
+    }
+
+    /**
+     * @return Iterator past the last integer.
+     */
+    iterator end() const {
+        return iterator();
+    }
+
+    /**
+     * @return Number of integers in the range.
+     */
+    size_t size() const {
+        return no;
+    }
+
+private:
+    size_t ni;
+    const uint8_t* input;
+    size_t no;
+};
+
+}
+
+#endif
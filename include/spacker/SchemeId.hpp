@@ -0,0 +1,100 @@
+#ifndef SPACKER_SCHEME_ID_HPP
+#define SPACKER_SCHEME_ID_HPP
+
+#include <cstdint>
+#include <array>
+#include <stdexcept>
+#include <limits>
+
+#include "Doubling.hpp"
+#include "Multiplier.hpp"
+#include "utils.hpp"
+
+/**
+ * @file SchemeId.hpp
+ *
+ * @brief Identify schemes at runtime.
+ */
+
+namespace spacker {
+
+/**
+ * Identifiers for the commonly used schemes.
+ * The numeric values are stored in packed streams and should not be changed.
+ */
+enum class SchemeId : uint8_t {
+    DOUBLING_1 = 0,
+    DOUBLING_2 = 1,
+    DOUBLING_4 = 2,
+    MULTIPLIER_4 = 3,
+    MULTIPLIER_8 = 4
+};
+
+/**
+ * All available scheme identifiers.
+ */
+inline constexpr std::array<SchemeId, 5> all_scheme_ids = {
+    SchemeId::DOUBLING_1,
+    SchemeId::DOUBLING_2,
+    SchemeId::DOUBLING_4,
+    SchemeId::MULTIPLIER_4,
+    SchemeId::MULTIPLIER_8
+};
+
+/**
+ * @tparam Function Function that accepts an instance of a scheme class, typically a generic lambda.
+ *
+ * @param id Identifier for the scheme.
+ * @param fun Function to be called with a default-constructed instance of the scheme corresponding to `id`.
+ * The scheme class can be recovered with `decltype`, and used to call the usual templated functions.
+ *
+ * @return The return value of `fun`, which should be the same for all schemes.
+ * A `std::runtime_error` is thrown for unknown identifiers, e.g., from corrupted streams.
+ */
+template<class Function>
+auto dispatch_scheme(SchemeId id, Function fun) {
+    switch (id) {
+        case SchemeId::DOUBLING_1:
+            return fun(Doubling<1>());
+        case SchemeId::DOUBLING_2:
+            return fun(Doubling<2>());
+        case SchemeId::DOUBLING_4:
+            return fun(Doubling<4>());
+        case SchemeId::MULTIPLIER_4:
+            return fun(Multiplier<4>());
+        case SchemeId::MULTIPLIER_8:
+            return fun(Multiplier<8>());
+    }
+    throw std::runtime_error("unknown scheme identifier");
+}
+
+/**
+ * @tparam T Type of the integers.
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @return Largest integer of type `T` that can be packed with `Scheme`.
+ *
+ * This includes the first code class that is wider than `T`, as `pack_psip()` fills the excess payload bits with zeros.
+ */
+template<typename T, class Scheme, int bits = 0>
+constexpr T max_packable() {
+    if constexpr(supports<T, Scheme, bits>()) {
+        if constexpr(bits < 7) {
+            return max_packable<T, Scheme, bits + 1>();
+        } else {
+            return max<T, Scheme, bits>();
+        }
+    } else {
+        constexpr T largest = std::numeric_limits<T>::max();
+        constexpr int available = Scheme::template width<bits>() - bits - 1;
+        if constexpr(available >= std::numeric_limits<T>::digits) {
+            return largest;
+        } else {
+            constexpr T space = (static_cast<T>(1) << available);
+            constexpr T previous = max<T, Scheme, bits - 1>();
+            return (previous > largest - space ? largest : previous + space);
+        }
+    }
+}
+}
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef SPACKER_SEEK_INDEX_HPP
+#define SPACKER_SEEK_INDEX_HPP
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @file SeekIndex.hpp
+ *
+ * @brief Index for random access into a packed stream.
+ */
+
+namespace spacker {
+
+/**
+ * @brief Position of a code in the packed stream.
+ */
+struct SeekPoint {
+    /**
+     * Offset of the byte containing the start of the code.
+     */
+    size_t byte;
+
+    /**
+     * Offset of the first bit of the code within `byte`, counting from the most significant bit.
+     */
+    int bit;
+
+    /**
+     * Number of integers that precede this code in the unpacked stream.
+     */
+    size_t count;
+};
+
+/**
+ * @brief Index of positions in a packed stream.
+ *
+ * This is filled by `pack_psip()` and used by `unpack_psip_range()` to decode a slice without decoding everything before it.
+ * Each point refers to the start of a code that does not depend on any previous codes, i.e., not an RLE marker.
+ */
+struct SeekIndex {
+    /**
+     * @param interval Number of integers between consecutive points.
+     */
+    SeekIndex(size_t interval = 1024) : interval(interval) {}
+
+    /**
+     * Number of integers between consecutive points.
+     * Points are placed at the first opportunity after each multiple of `interval`,
+     * so the actual spacing may be larger in the presence of RLE runs.
+     */
+    size_t interval;
+
+    /**
+     * Points in increasing order of `SeekPoint::count`.
+     */
+    std::vector<SeekPoint> points;
+};
+
+/**
+ * @brief Placeholder for when no index is to be created.
+ *
+ * This can be used in place of a `SeekIndex` so that all indexing is compiled away.
+ */
+struct NoIndex {};
+
+}
+
+#endif
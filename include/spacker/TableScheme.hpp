@@ -0,0 +1,119 @@
+#ifndef SPACKER_TABLE_SCHEME_HPP
+#define SPACKER_TABLE_SCHEME_HPP
+
+#include <array>
+#include <limits>
+
+/**
+ * @file TableScheme.hpp
+ *
+ * @brief Scheme with arbitrary code widths.
+ */
+
+namespace spacker {
+
+/**
+ * @param widths Width of the code for each number of preamble bits.
+ * @return Whether `widths` can be used in a `TableScheme`.
+ *
+ * Each width must be large enough to hold its preamble and the terminating zero, and no larger than 128 bits.
+ * Codes that fit into a single byte must precede all codes that do not, so that `TableScheme::max_bits_per_byte()` refers to a contiguous set of classes.
+ * The last code must not fit into a single byte.
+ * This does not consider the type of the integers, see the other `valid_table_widths()` overload.
+ */
+inline constexpr bool valid_table_widths(const std::array<int, 8>& widths) {
+    bool multi = false;
+    for (int b = 0; b < 8; ++b) {
+        int payload = widths[b] - b - 1;
+        if (payload < 0 || widths[b] > 128) {
+            return false;
+        }
+        if (widths[b] > 8) {
+            multi = true;
+        } else if (multi) {
+            return false;
+        }
+    }
+    return multi;
+}
+
+/**
+ * @tparam T Type of the integers.
+ * @param widths Width of the code for each number of preamble bits.
+ * @return Largest integer of type `T` that can be packed with a `TableScheme` using `widths`.
+ *
+ * This is the same as `max_packable()` but for widths that are only known at runtime.
+ * Classes are used in order until the first class that is wider than `T`, which takes all remaining integers that fit in its payload.
+ */
+template<typename T>
+constexpr T table_max_packable(const std::array<int, 8>& widths) {
+    constexpr int digits = std::numeric_limits<T>::digits;
+    constexpr T largest = std::numeric_limits<T>::max();
+    T current = 0;
+    for (int b = 0; b < 8; ++b) {
+        int payload = widths[b] - b - 1;
+        if (payload >= digits) {
+            return largest;
+        }
+        T space = (static_cast<T>(1) << payload);
+        current = (current > largest - space ? largest : current + space);
+        if (widths[b] > digits) {
+            break;
+        }
+    }
+    return current;
+}
+
+/**
+ * @tparam T Type of the integers.
+ * @param widths Width of the code for each number of preamble bits.
+ * @param limit Largest integer that should be representable.
+ * Defaults to the largest value of `T`.
+ *
+ * @return Whether `widths` can be used in a `TableScheme` to pack all integers of type `T` up to `limit`.
+ * This requires `widths` to satisfy the other `valid_table_widths()` overload and `table_max_packable()` to be no less than `limit`.
+ */
+template<typename T>
+constexpr bool valid_table_widths(const std::array<int, 8>& widths, T limit = std::numeric_limits<T>::max()) {
+    return valid_table_widths(widths) && table_max_packable<T>(widths) >= limit;
+}
+
+/**
+ * @brief Scheme with code widths taken from a table.
+ *
+ * @tparam w0,w1,w2,w3,w4,w5,w6,w7 Width of the code for each number of preamble bits, see `valid_table_widths()` for requirements.
+ *
+ * This generalizes `Doubling` and `Multiplier`, e.g., `TableScheme<1, 2, 4, 8, 16, 32, 64, 128>` is equivalent to `Doubling<1>`.
+ * Widths can be chosen to suit a particular distribution of integers, e.g., with `train_table_widths()`.
+ * Like `Doubling` and `Multiplier`, this only provides the members that are required of a scheme, i.e., `width()`, `width<bits>()` and `max_bits_per_byte()`.
+ */
+template<int w0, int w1, int w2, int w3, int w4, int w5, int w6, int w7>
+struct TableScheme {
+    /**
+     * Width of the code for each number of preamble bits.
+     */
+    static constexpr std::array<int, 8> widths = { w0, w1, w2, w3, w4, w5, w6, w7 };
+
+    static_assert(valid_table_widths(widths));
+
+    static int width(int bits) {
+        return widths[bits];
+    }
+
+    template<int bits>
+    static constexpr int width() {
+        return widths[bits];
+    }
+
+    static constexpr int max_bits_per_byte() {
+        int output = -1;
+        for (int b = 0; b < 8 && widths[b] <= 8; ++b) {
+            output = b;
+        }
+        return output;
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,167 @@
+#ifndef SPACKER_TRANSITION_TABLE_HPP
+#define SPACKER_TRANSITION_TABLE_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+/**
+ * @file TransitionTable.hpp
+ *
+ * @brief Byte-wise transition tables for decoding.
+ */
+
+namespace spacker {
+
+/**
+ * @brief Result of feeding a single byte to the decoder in a given state.
+ *
+ * Each state is defined by the number of bits in the preamble (if we're still in it) or the number of remaining payload bits.
+ * Consuming a byte completes zero or more codes and leaves the decoder in another state.
+ */
+struct Transition {
+    /**
+     * Number of codes that were completed in this byte.
+     */
+    uint8_t count;
+
+    /**
+     * Number of payload bits in this byte that belong to the first completed code.
+     * This is used to shift the payload that was accumulated from previous bytes.
+     */
+    uint8_t head;
+
+    /**
+     * Number of payload bits at the end of this byte that belong to an unfinished code.
+     */
+    uint8_t tail;
+
+    /**
+     * Number of preamble bits for the unfinished code at the end of this byte.
+     */
+    uint8_t next_bits;
+
+    /**
+     * Number of remaining payload bits for the unfinished code at the end of this byte.
+     * If zero, the decoder is still in the preamble.
+     */
+    uint16_t next_remaining;
+
+    /**
+     * Details for each completed code.
+     * The lower 3 bits contain the number of preamble bits, while the upper bits contain the right shift to extract the payload from this byte.
+     */
+    std::array<uint8_t, 8> codes;
+};
+
+/**
+ * @brief Transition tables for a `Scheme`.
+ *
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ *
+ * This contains a `Transition` for every combination of byte and state where the number of remaining payload bits is less than 8.
+ * States with more remaining bits can be handled by simply consuming the entire byte as payload.
+ */
+template<class Scheme>
+struct TransitionTable {
+private:
+    template<size_t... b>
+    static constexpr std::array<int, 8> compute_payloads(std::index_sequence<b...>) {
+        return { (Scheme::template width<b>() - static_cast<int>(b) - 1)... };
+    }
+
+public:
+    /**
+     * Number of payload bits in a code with each possible number of preamble bits.
+     */
+    static constexpr std::array<int, 8> payloads = compute_payloads(std::make_index_sequence<8>());
+
+    /**
+     * Number of states, i.e., 8 preamble states plus 7 payload states for each of the 8 preamble lengths.
+     */
+    static constexpr int num_states = 64;
+
+    /**
+     * @param bits Number of preamble bits.
+     * @param remaining Number of remaining payload bits, less than 8.
+     * If zero, we're still in the preamble.
+     *
+     * @return Index of the state.
+     */
+    static constexpr int state(int bits, int remaining) {
+        return (remaining == 0 ? bits : 8 + bits * 7 + remaining - 1);
+    }
+
+private:
+    static constexpr std::array<Transition, num_states * 256> build() {
+        std::array<Transition, num_states * 256> output{};
+
+        for (int s = 0; s < num_states; ++s) {
+            for (int v = 0; v < 256; ++v) {
+                auto& current = output[s * 256 + v];
+
+                bool preamble = (s < 8);
+                int bits = (preamble ? s : (s - 8) / 7);
+                int remaining = (preamble ? 0 : (s - 8) % 7 + 1);
+                int used = 0; // payload bits of the current code in this byte.
+
+                for (int p = 7; p >= 0; --p) {
+                    bool completed = false;
+
+                    if (preamble) {
+                        if (v & (1 << p)) {
+                            // Saturating, as more than 7 bits is not a valid encoding.
+                            if (bits < 7) {
+                                ++bits;
+                            }
+                        } else {
+                            preamble = false;
+                            remaining = payloads[bits];
+                            used = 0;
+                            completed = (remaining == 0);
+                        }
+                    } else {
+                        --remaining;
+                        ++used;
+                        completed = (remaining == 0);
+                    }
+
+                    if (completed) {
+                        if (current.count == 0) {
+                            current.head = used;
+                        }
+                        current.codes[current.count] = bits | (p << 3);
+                        ++current.count;
+                        preamble = true;
+                        bits = 0;
+                        used = 0;
+                    }
+                }
+
+                current.next_bits = bits;
+                if (!preamble) {
+                    current.next_remaining = remaining;
+                    current.tail = used;
+                }
+            }
+        }
+
+        return output;
+    }
+
+public:
+    /**
+     * Transitions for all states and bytes.
+     * The transition for state `s` and byte `v` is stored at `s * 256 + v`.
+     *
+     * This is not `constexpr` as building the table exceeds the default limits on constant evaluation for some compilers, e.g., Clang.
+     * Compilers that can evaluate `build()` within their limits (e.g., GCC) will use constant initialization;
+     * otherwise, the table is built once per `Scheme` during static initialization.
+     */
+    inline static const std::array<Transition, num_states * 256> entries = build();
+};
+
+}
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef SPACKER_ZIGZAG_HPP
+#define SPACKER_ZIGZAG_HPP
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+/**
+ * @file Zigzag.hpp
+ *
+ * @brief Map signed integers to positive codes.
+ */
+
+namespace spacker {
+
+/**
+ * @brief Zigzag transform for signed integers.
+ *
+ * @tparam T Signed integer type.
+ *
+ * Integers are mapped to codes in the order of 0, -1, 1, -2, 2, ..., which become 1, 2, 3, 4, 5, ...
+ * This ensures that integers with small magnitudes are assigned small codes, regardless of their sign.
+ * For 64-bit integers, the most negative value cannot be represented.
+ */
+template<typename T>
+struct Zigzag {
+    static_assert(std::is_signed<T>::value);
+
+    /**
+     * @param x Integer to be packed.
+     * @return Positive code for `x`.
+     */
+    static uint64_t forward(T x) {
+        typedef typename std::make_unsigned<T>::type U;
+        U z = (static_cast<U>(x) << 1) ^ static_cast<U>(x >> std::numeric_limits<T>::digits);
+        return static_cast<uint64_t>(z) + 1;
+    }
+
+    /**
+     * @param code Positive code from `forward()`.
+     * @return The original integer.
+     */
+    static T reverse(uint64_t code) {
+        typedef typename std::make_unsigned<T>::type U;
+        U z = static_cast<U>(code - 1);
+        return static_cast<T>((z >> 1) ^ (~(z & 1) + 1));
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef SPACKER_DISPATCH_HPP
+#define SPACKER_DISPATCH_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <string>
+
+#include "SchemeId.hpp"
+
+/**
+ * @file dispatch.hpp
+ *
+ * @brief Pack and unpack with a scheme chosen at runtime.
+ *
+ * These functions are defined in the compiled `spacker_dispatch` library, which contains pre-instantiated kernels for each `SchemeId` and integer type.
+ * Applications can link to this library instead of instantiating every combination of templates that they might need.
+ */
+
+namespace spacker {
+
+/**
+ * @param name Name of a scheme, i.e., `"doubling1"`, `"doubling2"`, `"doubling4"`, `"multiplier4"` or `"multiplier8"`.
+ * @return Identifier for the scheme.
+ * A `std::runtime_error` is thrown for unknown names.
+ */
+SchemeId parse_scheme_id(const std::string& name);
+
+/**
+ * @param id Identifier for the scheme.
+ * @param rle Whether to use run-length encoding.
+ * @param n Number of integers to be packed.
+ * @param input Pointer to an array of length `n`, containing the integers to be packed.
+ * @return Packed bytes, identical to those from `pack_psip()` with the corresponding template arguments.
+ */
+std::vector<uint8_t> pack_psip_dispatch(SchemeId id, bool rle, size_t n, const uint8_t* input);
+
+/**
+ * @overload
+ */
+std::vector<uint8_t> pack_psip_dispatch(SchemeId id, bool rle, size_t n, const uint16_t* input);
+
+/**
+ * @overload
+ */
+std::vector<uint8_t> pack_psip_dispatch(SchemeId id, bool rle, size_t n, const uint32_t* input);
+
+/**
+ * @overload
+ */
+std::vector<uint8_t> pack_psip_dispatch(SchemeId id, bool rle, size_t n, const uint64_t* input);
+
+/**
+ * @param id Identifier for the scheme.
+ * @param ni Number of bytes in the packed input.
+ * @param input Pointer to the packed input.
+ * @param no Number of integers to unpack.
+ * @param output Pointer to an array of length `no`, to store the unpacked integers.
+ * This is equivalent to `unpack_psip()` with the corresponding template arguments.
+ */
+void unpack_psip_dispatch(SchemeId id, size_t ni, const uint8_t* input, size_t no, uint8_t* output);
+
+/**
+ * @overload
+ */
+void unpack_psip_dispatch(SchemeId id, size_t ni, const uint8_t* input, size_t no, uint16_t* output);
+
+/**
+ * @overload
+ */
+void unpack_psip_dispatch(SchemeId id, size_t ni, const uint8_t* input, size_t no, uint32_t* output);
+
+/**
+ * @overload
+ */
+void unpack_psip_dispatch(SchemeId id, size_t ni, const uint8_t* input, size_t no, uint64_t* output);
+
+}
+
+#endif
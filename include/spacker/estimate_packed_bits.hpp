@@ -0,0 +1,177 @@
+#ifndef SPACKER_ESTIMATE_PACKED_BITS_HPP
+#define SPACKER_ESTIMATE_PACKED_BITS_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <tuple>
+#include <limits>
+#include <algorithm>
+
+#include "Doubling.hpp"
+#include "SchemeId.hpp"
+#include "pack_psip.hpp"
+#include "simd.hpp"
+
+/**
+ * @file estimate_packed_bits.hpp
+ *
+ * @brief Predict the size of the packed output without packing.
+ */
+
+namespace spacker {
+
+/**
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam T Type of the integers to be packed.
+ *
+ * @param histogram Pairs of distinct positive integers and their frequencies, e.g., from `psip_histogram()`.
+ *
+ * @return Total number of bits required to pack all integers in `histogram` without RLE,
+ * or the maximum value of `size_t` if some integers exceed `max_packable()` for `T` and `Scheme`.
+ * This takes time proportional to the number of distinct integers.
+ */
+template<class Scheme = Doubling<>, typename T = uint64_t>
+size_t estimate_packed_bits(const std::vector<std::pair<uint64_t, size_t> >& histogram) {
+    constexpr uint64_t limit = max_packable<T, Scheme>();
+    size_t total = 0;
+    for (const auto& h : histogram) {
+        if (h.first > limit) {
+            return std::numeric_limits<size_t>::max();
+        }
+        total += h.second * static_cast<size_t>(code_width<Scheme>(h.first));
+    }
+    return total;
+}
+
+/**
+ * @brief Summary of the runs in a sample of integers.
+ *
+ * This is created by `summarize_runs()` and used in `estimate_packed_bits()` to account for RLE.
+ */
+struct RunSummary {
+    /**
+     * Total number of integers in the original array.
+     */
+    size_t total = 0;
+
+    /**
+     * Number of integers in the sample.
+     */
+    size_t sampled = 0;
+
+    /**
+     * Distinct combinations of value and run length in the sample, along with the number of runs for each combination.
+     * Sorted by increasing value and then increasing run length.
+     */
+    std::vector<std::tuple<uint64_t, size_t, size_t> > runs;
+};
+
+/**
+ * @tparam T Type of the integers.
+ *
+ * @param n Number of integers.
+ * @param input Pointer to an array of length `n`, containing positive integers.
+ * @param sample_size Approximate number of integers to sample.
+ * If this is not less than `n`, all integers are used.
+ * @param chunk_size Number of consecutive integers in each sampled chunk.
+ * Larger values preserve longer runs at the cost of covering fewer parts of `input`.
+ *
+ * @return Summary of the runs in evenly spaced chunks of `input`.
+ * Runs that cross chunk boundaries are split.
+ * This only needs to be computed once for an array, after which `estimate_packed_bits()` can be called cheaply for any number of schemes.
+ */
+template<typename T>
+RunSummary summarize_runs(size_t n, const T* input, size_t sample_size = 65536, size_t chunk_size = 4096) {
+    size_t nchunks = 1;
+    if (sample_size >= n || chunk_size >= n) {
+        chunk_size = n;
+    } else {
+        chunk_size = std::max(chunk_size, static_cast<size_t>(1));
+        nchunks = std::max(sample_size / chunk_size, static_cast<size_t>(1));
+    }
+
+    std::vector<std::tuple<uint64_t, size_t, size_t> > runs;
+    RunSummary output;
+    output.total = n;
+
+    size_t spacing = (nchunks > 1 ? (n - chunk_size) / (nchunks - 1) : 0);
+    for (size_t c = 0; c < nchunks; ++c) {
+        size_t start = c * spacing;
+        size_t end = std::min(n, start + chunk_size);
+        output.sampled += end - start;
+
+        size_t i = start;
+        while (i < end) {
+            size_t len = count_run(end - i, input + i);
+            runs.emplace_back(input[i], len, 1);
+            i += len;
+        }
+    }
+
+    std::sort(runs.begin(), runs.end());
+    for (const auto& r : runs) {
+        if (!output.runs.empty() && std::get<0>(output.runs.back()) == std::get<0>(r) && std::get<1>(output.runs.back()) == std::get<1>(r)) {
+            ++std::get<2>(output.runs.back());
+        } else {
+            output.runs.push_back(r);
+        }
+    }
+
+    return output;
+}
+
+/**
+ * @tparam rle Whether to use run-length encoding.
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam T Type of the integers to be packed.
+ *
+ * @param summary Summary of the runs, typically created by `summarize_runs()`.
+ *
+ * @return Estimated number of bits required to pack the original array,
+ * or the maximum value of `size_t` if some integers exceed `max_packable()` for `T` and `Scheme`.
+ *
+ * For each run, the cost of the repeated literals is compared to that of the RLE marker, length and padding,
+ * averaging over all possible amounts of padding as the actual padding depends on the position of the run.
+ * The total cost for the sample is then scaled up to the size of the original array.
+ * This takes time proportional to the number of distinct combinations of value and run length.
+ */
+template<bool rle = true, class Scheme = Doubling<>, typename T = uint64_t>
+size_t estimate_packed_bits(const RunSummary& summary) {
+    constexpr uint64_t limit = max_packable<T, Scheme>();
+    double total = 0;
+
+    for (const auto& r : summary.runs) {
+        uint64_t val = std::get<0>(r);
+        size_t len = std::get<1>(r);
+        if (val > limit) {
+            return std::numeric_limits<size_t>::max();
+        }
+
+        size_t width = code_width<Scheme>(val);
+        size_t naive = width * len;
+        double cost = naive;
+        if constexpr(rle) {
+            if (len > 1) {
+                // Padding is assumed to be uniformly distributed from 0 to 7 bits,
+                // and the packer chooses the cheaper encoding for each amount of padding.
+                size_t encoded = width + 8 + code_width<Scheme>(len);
+                size_t sum = 0;
+                for (size_t padding = 0; padding < 8; ++padding) {
+                    sum += std::min(naive, encoded + padding);
+                }
+                cost = sum / 8.0;
+            }
+        }
+        total += cost * std::get<2>(r);
+    }
+
+    if (summary.sampled) {
+        total *= static_cast<double>(summary.total) / summary.sampled;
+    }
+    return static_cast<size_t>(total + 0.5);
+}
+
+}
+
+#endif
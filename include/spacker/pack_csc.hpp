@@ -0,0 +1,137 @@
+#ifndef SPACKER_PACK_CSC_HPP
+#define SPACKER_PACK_CSC_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Doubling.hpp"
+#include "pack_psip.hpp"
+#include "pack_psip_deltas.hpp"
+
+/**
+ * @file pack_csc.hpp
+ *
+ * @brief Pack a sparse matrix in compressed sparse column format.
+ */
+
+namespace spacker {
+
+/**
+ * @brief Packed representation of a compressed sparse column matrix.
+ *
+ * The structural non-zero values and the row indices of each column are packed separately with `pack_psip()`.
+ * Row indices are delta-coded within each column with `pack_psip_deltas()`.
+ */
+struct PackedCsc {
+    /**
+     * Number of rows.
+     */
+    size_t nrow = 0;
+
+    /**
+     * Number of columns.
+     */
+    size_t ncol = 0;
+
+    /**
+     * Column pointers, of length `ncol + 1`, where the first entry is always zero.
+     * The number of structural non-zeros in column `c` is `pointers[c + 1] - pointers[c]`.
+     */
+    std::vector<size_t> pointers;
+
+    /**
+     * Packed values for all columns, concatenated together.
+     */
+    std::vector<uint8_t> values;
+
+    /**
+     * Offsets of the packed values for each column in `values`, of length `ncol + 1`.
+     */
+    std::vector<size_t> value_offsets;
+
+    /**
+     * Packed row index deltas for all columns, concatenated together.
+     */
+    std::vector<uint8_t> indices;
+
+    /**
+     * Offsets of the packed row index deltas for each column in `indices`, of length `ncol + 1`.
+     */
+    std::vector<size_t> index_offsets;
+};
+
+/**
+ * @tparam rle Whether to use run-length encoding.
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam Code Integer type used to pack the values.
+ * @tparam Pointer Type of the column pointers.
+ * @tparam Index Type of the row indices.
+ * @tparam Value Type of the values.
+ *
+ * @param nrow Number of rows.
+ * @param ncol Number of columns.
+ * @param p Pointer to an array of length `ncol + 1`, containing the column pointers.
+ * These are used as offsets into `i` and `x`, and `p[0]` need not be zero, e.g., when packing a subset of columns from a larger matrix.
+ * @param i Pointer to an array of length `p[ncol]`, containing the row indices.
+ * These should be strictly increasing within each column.
+ * @param x Pointer to an array of length `p[ncol]`, containing the values.
+ * These should be positive integers that can be represented by `Code`, e.g., counts stored as `double`.
+ *
+ * @return The packed matrix.
+ * Its `PackedCsc::pointers` are shifted to start at zero, i.e., they are equal to `p[c] - p[0]` for each column `c`.
+ *
+ * All columns are packed in a single pass with a shared scratch buffer, so there is no allocation per column.
+ * A `std::runtime_error` is thrown if the row indices of any column are not strictly increasing or are not less than `nrow`.
+ */
+template<bool rle = true, class Scheme = Doubling<>, typename Code = uint32_t, typename Pointer, typename Index, typename Value>
+PackedCsc pack_csc(size_t nrow, size_t ncol, const Pointer* p, const Index* i, const Value* x) {
+    PackedCsc output;
+    output.nrow = nrow;
+    output.ncol = ncol;
+
+    output.pointers.reserve(ncol + 1);
+    output.value_offsets.reserve(ncol + 1);
+    output.index_offsets.reserve(ncol + 1);
+    output.pointers.push_back(0);
+    output.value_offsets.push_back(0);
+    output.index_offsets.push_back(0);
+
+    size_t base = (ncol ? static_cast<size_t>(p[0]) : 0);
+    size_t nnz = (ncol ? static_cast<size_t>(p[ncol]) - base : 0);
+    output.values.reserve(nnz / 4);
+    output.indices.reserve(nnz / 4);
+
+    std::vector<Code> scratch;
+    for (size_t c = 0; c < ncol; ++c) {
+        size_t start = p[c], end = p[c + 1];
+        size_t len = end - start;
+        output.pointers.push_back(end - base);
+
+        if constexpr(std::is_same<Value, Code>::value) {
+            pack_psip_append<rle, Scheme>(len, x + start, output.values);
+        } else {
+            scratch.resize(len);
+            for (size_t k = 0; k < len; ++k) {
+                scratch[k] = static_cast<Code>(x[start + k]);
+            }
+            pack_psip_append<rle, Scheme>(len, scratch.data(), output.values);
+        }
+        output.value_offsets.push_back(output.values.size());
+
+        // Strict increase is checked by pack_psip_deltas_append(), so we only need to check the last index.
+        if (len && static_cast<size_t>(i[end - 1]) >= nrow) {
+            throw std::runtime_error("row indices should be less than the number of rows");
+        }
+        pack_psip_deltas_append<rle, Scheme>(len, i + start, output.indices);
+        output.index_offsets.push_back(output.indices.size());
+    }
+
+    return output;
+}
+
+}
+
+#endif
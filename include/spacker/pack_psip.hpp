@@ -2,11 +2,19 @@
 #define SPACKER_PACK_HPP
 
 #include <cstdint>
+#include <cstddef>
 #include <vector>
+#include <array>
 #include <limits>
+#include <algorithm>
+#include <type_traits>
 
 #include "utils.hpp"
 #include "Doubling.hpp"
+#include "SeekIndex.hpp"
+#include "BitWriter.hpp"
+#include "simd.hpp"
+#include "PackStats.hpp"
 
 /**
  * @file pack_psip.hpp
@@ -16,275 +24,442 @@
 
 namespace spacker {
 
-template<typename T, int max_bits, class Scheme, int start_bits>
-inline void determine_bits(T& val, int& bits) {
-    if constexpr(start_bits == max_bits) {
-        bits = start_bits;        
-        val -= min<T, Scheme, start_bits>();
-    } else {
-        if constexpr(supports<T, Scheme, start_bits>()) {
-            if (val <= max<T, Scheme, start_bits>()) {
-                bits = start_bits;
-                val -= min<T, Scheme, start_bits>();
-            } else {
-                determine_bits<T, max_bits, Scheme, start_bits + 1>(val, bits);
-            }
-        } else {
-            bits = start_bits;
-            val -= min<T, Scheme, start_bits>();
-        }
+template<typename T>
+struct CodeClasses {
+    // Number of classes with an upper bound; all larger integers are assigned to the class after these.
+    int bounded = 0;
+
+    std::array<T, 8> maxima{};
+    std::array<T, 8> minima{};
+    std::array<int, 8> widths{};
+
+    // Preamble of each code, already shifted to sit above the payload; only used for codes of up to 64 bits.
+    std::array<uint64_t, 8> prefixes{};
+
+    // Number of following integers that must be equal for a run to pass the approximate RLE check, capped at 8 and stored as a bitmask.
+    std::array<unsigned, 8> lookahead{};
+};
+
+template<typename T, class Scheme, int bits = 0>
+constexpr void fill_code_classes(CodeClasses<T>& classes) {
+    constexpr int width = Scheme::template width<bits>();
+    classes.widths[bits] = width;
+    classes.minima[bits] = min<T, Scheme, bits>();
+    if constexpr(bits > 0 && width <= 64) {
+        classes.prefixes[bits] = ((static_cast<uint64_t>(1) << bits) - 1) << (width - bits);
     }
-    return;
+
+    // Runs that are no longer than 1 + 8 / width always fail the approximate check in pack_psip_run().
+    constexpr int ahead = std::min(8 / width + 1, 8);
+    classes.lookahead[bits] = (1u << ahead) - 1;
+
+    // Same as the class selection in max_packable(), i.e., stopping at the first class that is wider than T.
+    if constexpr(bits < 7 && supports<T, Scheme, bits>()) {
+        classes.maxima[bits] = max<T, Scheme, bits>();
+        classes.bounded = bits + 1;
+        fill_code_classes<T, Scheme, bits + 1>(classes);
+    }
+}
+
+template<typename T, class Scheme>
+constexpr CodeClasses<T> make_code_classes() {
+    CodeClasses<T> classes;
+    fill_code_classes<T, Scheme>(classes);
+    return classes;
 }
 
+template<typename T, class Scheme>
+inline constexpr CodeClasses<T> code_classes = make_code_classes<T, Scheme>();
+
 template<class Scheme, typename T>
-inline constexpr int min_bits_per_byte() {
-    if constexpr(max<T, Scheme, 0>() == 1) {
-        return 1;
-    } else {
-        return 0;
+int find_code_class(T val) {
+    // Counting the exceeded bounds, which is branch-free and avoids mispredictions when the classes are mixed.
+    constexpr const CodeClasses<T>& classes = code_classes<T, Scheme>;
+    int bits = 0;
+    for (int b = 0; b < classes.bounded; ++b) {
+        bits += (val > classes.maxima[b]);
     }
+    return bits;
 }
 
+/**
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam T Type of the integer.
+ *
+ * @param val Integer to be packed.
+ * @return Number of bits in the packed code for `val`.
+ */
 template<class Scheme, typename T>
-int pack_psip_inner(T val, int& leftover, uint8_t& buffer, std::vector<uint8_t>& output) {
-    constexpr int width = 8;
+int code_width(T val) {
+    return code_classes<T, Scheme>.widths[find_code_class<Scheme>(val)];
+}
 
-    // Packed version is a single bit.
-    if constexpr(max<T, Scheme, 0>() == 1) {
-        if (val == 1) {
-            buffer <<= 1;
-            --leftover; 
-            if (leftover == 0) {
-                output.push_back(buffer);
-                leftover = width;
-                buffer = 0;
-            }
-            return 1;
-        }
+/**
+ * @brief Write packed bytes to a caller-allocated array.
+ *
+ * This can be used in place of a `std::vector<uint8_t>` as the output of the packing functions.
+ * No capacity checks are performed, so the array should be large enough, e.g., as determined by `packed_size()`.
+ */
+struct RawOutput {
+    /**
+     * @param ptr Pointer to the start of the array.
+     */
+    RawOutput(uint8_t* ptr) : start(ptr), ptr(ptr) {}
+
+    /**
+     * @param val Byte to be written.
+     */
+    void push_back(uint8_t val) {
+        *ptr = val;
+        ++ptr;
     }
 
-    if constexpr(Scheme::max_bits_per_byte() >= 0) {
-        // Packed version fits into 1 byte.
-        if (val <= max<T, Scheme, Scheme::max_bits_per_byte()>()) {
-            int bits;
-            determine_bits<T, Scheme::max_bits_per_byte(), Scheme, min_bits_per_byte<Scheme, T>()>(val, bits);
-
-            const int required = Scheme::width(bits);
-            uint8_t signature = (static_cast<uint8_t>(1) << (bits + 1)) - 2;
-            signature <<= required - bits - 1;
-            signature |= val;
-
-            // Can it fit into 1 byte, or do we have to split it across 2?
-            if (required <= leftover) {
-                if (required < width) {
-                    buffer <<= required;
-                    buffer |= signature;
-                } else {
-                    buffer = signature;
-                }
-                leftover -= required;
-                if (leftover == 0) {
-                    output.push_back(buffer);
-                    leftover = width;
-                    buffer = 0;
-                }
-            } else {
-                // not possible for leftover == width here, otherwise
-                // it would have fallen into the previous clause.
-                buffer <<= leftover; 
-
-                // not possible for leftover = 0, so overflow < width.
-                int overflow = required - leftover;
-                auto first = (signature >> overflow);
-                buffer |= first;
-                output.push_back(buffer);
-
-                buffer = 0;
-                buffer |= signature ^ (first << overflow); // Effectively subtraction, as RHS can only be 1 when LHS is 1.
-                leftover = width - overflow;
-            }
+    /**
+     * @return Number of bytes written.
+     */
+    size_t size() const {
+        return ptr - start;
+    }
 
-            return required;
-        }
-    } 
-    
-    // No chance of fitting in a single uint8_t.
-    int bits;
-    determine_bits<T, 7, Scheme, Scheme::max_bits_per_byte() + 1>(val, bits);
-    const int siglen = bits + 1;
-    const uint8_t preamble = (siglen == width ? std::numeric_limits<uint8_t>::max() - 1 : (static_cast<uint8_t>(1) << siglen) - 2); 
-
-    // Adding the preamble first.
-    if (siglen <= leftover) {
-        if (leftover == width) {
-            buffer = preamble;
-        } else {
-            buffer <<= siglen;
-            buffer |= preamble;
-        }
+private:
+    uint8_t* start;
+    uint8_t* ptr;
 
-        leftover -= siglen;
-        if (leftover == 0) {
-            output.push_back(buffer);
-            leftover = width;
-            buffer = 0;
-        }
-    } else {
-        // leftover < width must be true here, as otherwise
-        // we would have entered the clause above.
-        buffer <<= leftover;
-
-        // siglen cannot be greater than width, and it's not possible for
-        // leftover = 0, so overflow < width.
-        int overflow = siglen - leftover;
-        auto first = (preamble >> overflow);
-        buffer |= first;
-        output.push_back(buffer);
-
-        buffer = 0;
-        buffer |= preamble ^ (first << overflow); 
-        leftover = width - overflow;
+    friend void append_word(uint64_t, RawOutput&);
+};
+
+inline void append_word(uint64_t word, RawOutput& output) {
+    store_big_endian(word, output.ptr);
+    output.ptr += 8;
+}
+
+template<class Scheme, typename T, class Output>
+int pack_psip_code(T val, int bits, BitWriter& writer, Output& output) {
+    constexpr const CodeClasses<T>& classes = code_classes<T, Scheme>;
+    const int required = classes.widths[bits];
+    val -= classes.minima[bits];
+    if (required <= 64) {
+        writer.write(classes.prefixes[bits] | static_cast<uint64_t>(val), required, output);
+        return required;
     }
 
-    // Adding the rest of the signature. This requires some fiddling
-    // to account for potential differences in integer width.
-    const int required = Scheme::width(bits);
-    int remaining = required - siglen;
+    // Wide codes are written in pieces, with zeros for any payload bits beyond the width of T.
+    const int payload = required - bits - 1;
+    writer.write(((static_cast<uint64_t>(1) << bits) - 1) << 1, bits + 1, output);
     constexpr int available = std::numeric_limits<T>::digits;
+    int remaining = payload;
+    while (remaining > available) {
+        int chunk = std::min(remaining - available, 64);
+        writer.write(0, chunk, output);
+        remaining -= chunk;
+    }
+    writer.write(static_cast<uint64_t>(val), remaining, output);
+    return required;
+}
+
+template<class Scheme, typename T, class Output>
+int pack_psip_inner(T val, BitWriter& writer, Output& output) {
+    return pack_psip_code<Scheme>(val, find_code_class<Scheme>(val), writer, output);
+}
 
-    if (leftover < width) {
-        buffer <<= leftover;
+template<class Scheme, typename T, class Output>
+void pack_psip_repeat(T val, int required, size_t count, BitWriter& writer, Output& output) {
+    constexpr int word = 64;
+    if (required > word / 2 || count < 2) {
+        for (size_t c = 0; c < count; ++c) {
+            pack_psip_inner<Scheme>(val, writer, output);
+        }
+        return;
+    }
 
-        // The smallest possible 'required' should be greater than width, i.e.,
-        // an encoding that takes up more than a byte should provide at least a
-        // byte's worth of available bits.
-        static_assert(Scheme::template width<Scheme::max_bits_per_byte() + 1>() - (Scheme::max_bits_per_byte() - 1) - 1 >= width);
+    // Replicating short codes into a single word, so that multiple copies are written at once.
+    constexpr const CodeClasses<T>& classes = code_classes<T, Scheme>;
+    int bits = find_code_class<Scheme>(val);
+    const uint64_t code = classes.prefixes[bits] | static_cast<uint64_t>(val - classes.minima[bits]);
 
-        // This is the shift to be applied to obtain the 8 bits of interest.
-        // This is guaranteed to be positive as remaining is guaranteed to be
-        // at least width if the above static_assert passes (and in this 
-        // clause we already know that leftover < width).
-        remaining -= leftover; 
+    const size_t per_word = word / required;
+    uint64_t pattern = 0;
+    for (size_t p = 0; p < per_word; ++p) {
+        pattern = (pattern << required) | code;
+    }
 
-        if (remaining < available) {
-            auto of_interest = (val >> remaining) & 0b11111111;
-            buffer |= static_cast<uint8_t>(of_interest);
-        } else {
-            ; // nothing to do; only zeros to add to the buffer.
-        }
+    const int pattern_width = per_word * required;
+    for (; count >= per_word; count -= per_word) {
+        writer.write(pattern, pattern_width, output);
+    }
 
-        output.push_back(buffer);
-    } else {
-        ; // if leftover = width, buffer should have already been set to 0.
+    // The lowest bits of the pattern always contain complete copies of the code.
+    if (count) {
+        int remaining = count * required;
+        writer.write(pattern & ((static_cast<uint64_t>(1) << remaining) - 1), remaining, output);
     }
+}
 
-    // Looping through all additional full-size bytes occupied by the current value.
-    while (remaining >= width) {
-        remaining -= width; 
-        if (remaining >= available) {
-            output.push_back(0);
-        } else {
-            auto of_interest = (val >> remaining) & 0b11111111;
-            output.push_back(static_cast<uint8_t>(of_interest));
-        }
-    } 
-
-    // Clearing out the remaining bytes.
-    if (remaining) {
-        leftover = width - remaining;
-        int shift = available - remaining;
-        auto of_interest = (val << shift) >> shift; // guaranteed to be valid, as shift < T's width when remaining > 0.
-        buffer = static_cast<uint8_t>(of_interest);
-    } else {
-        leftover = width;
-        buffer = 0;
+template<class Scheme, typename T, class Stats>
+void record_literals(T val, size_t count, Stats& stats) {
+    if constexpr(!std::is_same<Stats, NoStats>::value) {
+        int bits = find_code_class<Scheme>(val);
+        stats.add_literals(bits, code_classes<T, Scheme>.widths[bits], count);
     }
+}
 
-    return required;
+template<class Scheme, class Output>
+void pack_psip_rle(size_t count, BitWriter& writer, Output& output) {
+    // Padding the current byte with 1's, adding the RLE marker and then the length.
+    writer.pad_with_ones(output);
+    writer.write(0b11111111, 8, output);
+    pack_psip_inner<Scheme>(count, writer, output);
 }
 
-template<bool rle = true, class Scheme = Doubling<>, typename T>
-std::vector<uint8_t> pack_psip (size_t n, const T* input) {
-    size_t i = 0;
-    uint8_t buffer = 0;
+template<bool rle, class Scheme, typename T, class Output, class Stats>
+void pack_psip_run(T val, size_t count, BitWriter& writer, Output& output, Stats& stats) {
     constexpr int width = 8;
-    int leftover = width;
+    int required = pack_psip_inner<Scheme>(val, writer, output);
 
-    std::vector<uint8_t> output;
-    output.reserve(n/10);
+    if constexpr(rle) {
+        // Approximate cost-effectiveness check.
+        size_t naive_cost = required * count;
+        size_t rle_cost = width + required;
+        if (naive_cost > rle_cost) {
 
-    while (i < n) {
-        auto val = input[i];
-        int required = pack_psip_inner<Scheme>(val, leftover, buffer, output);
+            // Exact cost-effectiveness check.
+            rle_cost += code_width<Scheme>(count);
+            rle_cost += writer.padding();
 
-        if constexpr(rle) {
-            auto copy = i + 1;
-            while (copy < n && val == input[copy]) {
-                ++copy;
+            if (naive_cost > rle_cost) {
+                record_literals<Scheme>(val, 1, stats);
+                stats.add_rle(writer.padding());
+
+                pack_psip_rle<Scheme>(count, writer, output);
+                return;
             }
 
-            // Approximate cost-effectiveness check.
-            bool use_rle = false;
-            size_t count = copy - i;
-            size_t naive_cost = required * count;
-            size_t rle_cost = width + required;
-            if (naive_cost > rle_cost) {
+            stats.add_rejected(true);
+        } else if (count > 1) {
+            stats.add_rejected(false);
+        }
+    }
 
-                // Exact cost-effectiveness check.
-                int run_bits;
-                size_t count_copy = count;
-                determine_bits<size_t, 7, Scheme, 0>(count_copy, run_bits);
-                rle_cost += Scheme::width(run_bits);
-                if (leftover < width && leftover > 0) {
-                    rle_cost += leftover;
-                }
+    record_literals<Scheme>(val, count, stats);
+    pack_psip_repeat<Scheme>(val, required, count - 1, writer, output);
+}
 
-                if (naive_cost > rle_cost) {
-                    if (leftover < width && leftover > 0) { 
-                        // Padding the current buffer with 1's.
-                        uint8_t mask = 1;
-                        mask <<= leftover;
-                        mask -= 1;
-
-                        buffer <<= leftover;
-                        buffer |= mask;
-                        output.push_back(buffer);
-
-                        leftover = width;
-                        buffer = 0;
-                    }
+template<bool rle, class Scheme, typename T, class Output>
+void pack_psip_run(T val, size_t count, BitWriter& writer, Output& output) {
+    NoStats stats;
+    pack_psip_run<rle, Scheme>(val, count, writer, output, stats);
+}
 
-                    // Adding the RLE marker.
-                    output.push_back(0b11111111);
+template<class Output>
+void pack_psip_finish(BitWriter& writer, Output& output) {
+    writer.finish(output);
+}
 
-                    // Adding the length.
-                    pack_psip_inner<Scheme>(count, leftover, buffer, output);
+template<bool rle, class Scheme, typename T, class Output, class Index, class Stats>
+void pack_psip_internal(size_t n, const T* input, Output& output, Index& index, Stats& stats) {
+    constexpr bool indexed = std::is_same<Index, SeekIndex>::value;
+    size_t i = 0;
+    BitWriter writer;
+
+    size_t checkpoint = 0;
+    size_t interval = 1;
+    if constexpr(indexed) {
+        index.points.clear();
+        interval = std::max(index.interval, interval);
+        checkpoint = interval;
+    }
 
-                    i = copy;
-                    use_rle = true;
-                }
+    while (i < n) {
+        if constexpr(indexed) {
+            if (i >= checkpoint) {
+                size_t position = output.size() * 8 + writer.pending(); // in bits.
+                index.points.push_back(SeekPoint{ position / 8, static_cast<int>(position % 8), i });
+                checkpoint = (i / interval + 1) * interval;
             }
+        }
 
-            if (!use_rle) {
-                while ((++i) != copy) {
-                    pack_psip_inner<Scheme>(val, leftover, buffer, output);
+        auto val = input[i];
+        if constexpr(rle) {
+            if constexpr(!indexed && std::is_same<Stats, NoStats>::value) {
+                // Literals that are not followed by enough copies to pass the approximate check in pack_psip_run() are written directly.
+                // This gives the same output without counting each run, which is costly when most runs are short.
+                // It is skipped when indexing or collecting statistics, as these are recorded for each run.
+                constexpr int ahead = 8;
+                if (n - i > ahead) {
+                    int bits = find_code_class<Scheme>(val);
+                    if (find_mismatches(input + i + 1, val) & code_classes<T, Scheme>.lookahead[bits]) {
+                        pack_psip_code<Scheme>(val, bits, writer, output);
+                        ++i;
+                        continue;
+                    }
                 }
             }
 
+            auto copy = i + count_run(n - i, input + i);
+            pack_psip_run<rle, Scheme>(val, copy - i, writer, output, stats);
+            i = copy;
         } else {
+            record_literals<Scheme>(val, 1, stats);
+            pack_psip_inner<Scheme>(val, writer, output);
             ++i;
         }
     }
 
-    if (leftover != width) {
-        buffer <<= leftover;
-        output.push_back(buffer);
-    }
+    pack_psip_finish(writer, output);
+}
+
+/**
+ * @tparam rle Whether to use run-length encoding.
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam T Type of the integers to be packed.
+ * @tparam Output Container of bytes, e.g., a `std::vector<uint8_t>` with a custom allocator.
+ * This should support `push_back()` and `reserve()`.
+ *
+ * @param n Number of integers to be packed.
+ * @param input Pointer to an array of length `n`, containing the integers to be packed.
+ *
+ * @return Packed bytes.
+ */
+template<bool rle = true, class Scheme = Doubling<>, typename T, class Output = std::vector<uint8_t> >
+Output pack_psip (size_t n, const T* input) {
+    Output output;
+    output.reserve(n/10);
+    NoIndex index;
+    NoStats stats;
+    pack_psip_internal<rle, Scheme>(n, input, output, index, stats);
+    return output;
+}
+
+/**
+ * @tparam rle Whether to use run-length encoding.
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam T Type of the integers to be packed.
+ * @tparam Output Container of bytes that supports `push_back()`.
+ *
+ * @param n Number of integers to be packed.
+ * @param input Pointer to an array of length `n`, containing the integers to be packed.
+ * @param output Container to which the packed bytes are appended.
+ * These are identical to the bytes returned by `pack_psip()`, so multiple vectors can be packed back-to-back into the same container.
+ */
+template<bool rle = true, class Scheme = Doubling<>, typename T, class Output>
+void pack_psip_append(size_t n, const T* input, Output& output) {
+    NoIndex index;
+    NoStats stats;
+    pack_psip_internal<rle, Scheme>(n, input, output, index, stats);
+}
 
+/**
+ * @tparam rle Whether to use run-length encoding.
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam T Type of the integers to be packed.
+ * @tparam Output Container of bytes, see the other `pack_psip()` overload.
+ *
+ * @param n Number of integers to be packed.
+ * @param input Pointer to an array of length `n`, containing the integers to be packed.
+ * @param index Index to be filled with the positions of codes in the packed stream, at intervals of `SeekIndex::interval`.
+ * Any existing points are replaced.
+ *
+ * @return Packed bytes, identical to those from the other `pack_psip()` overload.
+ */
+template<bool rle = true, class Scheme = Doubling<>, typename T, class Output = std::vector<uint8_t> >
+Output pack_psip (size_t n, const T* input, SeekIndex& index) {
+    Output output;
+    output.reserve(n/10);
+    NoStats stats;
+    pack_psip_internal<rle, Scheme>(n, input, output, index, stats);
+    return output;
+}
+
+/**
+ * @tparam rle Whether to use run-length encoding.
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam T Type of the integers to be packed.
+ * @tparam Output Container of bytes, see the other `pack_psip()` overload.
+ *
+ * @param n Number of integers to be packed.
+ * @param input Pointer to an array of length `n`, containing the integers to be packed.
+ * @param stats Statistics on the packing decisions, to which the counts for this stream are added.
+ *
+ * @return Packed bytes, identical to those from the other `pack_psip()` overload.
+ */
+template<bool rle = true, class Scheme = Doubling<>, typename T, class Output = std::vector<uint8_t> >
+Output pack_psip (size_t n, const T* input, PackStats& stats) {
+    Output output;
+    output.reserve(n/10);
+    NoIndex index;
+    pack_psip_internal<rle, Scheme>(n, input, output, index, stats);
     return output;
 }
 
+/**
+ * @tparam rle Whether to use run-length encoding.
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam T Type of the integers to be packed.
+ *
+ * @param n Number of integers to be packed.
+ * @param input Pointer to an array of length `n`, containing the integers to be packed.
+ *
+ * @return Exact number of bytes in the output of `pack_psip()`.
+ * This only involves arithmetic on the code widths, without writing any bytes.
+ */
+template<bool rle = true, class Scheme = Doubling<>, typename T>
+size_t packed_size(size_t n, const T* input) {
+    constexpr int width = 8;
+    size_t position = 0; // in bits.
+    size_t i = 0;
+
+    while (i < n) {
+        auto val = input[i];
+        size_t required = code_width<Scheme>(val);
+        position += required;
+
+        if constexpr(rle) {
+            auto copy = i + count_run(n - i, input + i);
+            size_t count = copy - i;
+            i = copy;
+
+            // Same cost-effectiveness checks as in pack_psip_run().
+            size_t naive_cost = required * count;
+            size_t rle_cost = width + required;
+            if (naive_cost > rle_cost) {
+                size_t run_width = code_width<Scheme>(count);
+                size_t padding = (width - position % width) % width;
+                rle_cost += run_width + padding;
+                if (naive_cost > rle_cost) {
+                    position += padding + width + run_width;
+                    continue;
+                }
+            }
+
+            position += required * (count - 1);
+        } else {
+            ++i;
+        }
+    }
+
+    return (position + width - 1) / width;
+}
+
+/**
+ * @tparam rle Whether to use run-length encoding.
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam T Type of the integers to be packed.
+ *
+ * @param n Number of integers to be packed.
+ * @param input Pointer to an array of length `n`, containing the integers to be packed.
+ * @param output Pointer to an array of length no less than `packed_size()`, to store the packed bytes.
+ *
+ * @return Number of bytes written to `output`.
+ * The bytes are identical to those returned by `pack_psip()`.
+ */
+template<bool rle = true, class Scheme = Doubling<>, typename T>
+size_t pack_psip_into(size_t n, const T* input, uint8_t* output) {
+    RawOutput raw(output);
+    NoIndex index;
+    NoStats stats;
+    pack_psip_internal<rle, Scheme>(n, input, raw, index, stats);
+    return raw.size();
+}
 }
 
 #endif
@@ -0,0 +1,173 @@
+#ifndef SPACKER_PACK_ADAPTIVE_HPP
+#define SPACKER_PACK_ADAPTIVE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+#include "SchemeId.hpp"
+#include "pack_psip.hpp"
+#include "simd.hpp"
+#include "pack_psip_blocked.hpp"
+#include "parallelize.hpp"
+
+/**
+ * @file pack_psip_adaptive.hpp
+ *
+ * @brief Pack independent blocks with the cheapest scheme for each block.
+ */
+
+namespace spacker {
+
+template<typename T, class Scheme, int bits = 0>
+void append_class_bounds(std::vector<T>& output) {
+    if constexpr(supports<T, Scheme, bits>()) {
+        output.push_back(max<T, Scheme, bits>());
+        if constexpr(bits < 7) {
+            append_class_bounds<T, Scheme, bits + 1>(output);
+        }
+    } else {
+        // The first class that is wider than T is still used by pack_psip(), up to the limit of its payload.
+        output.push_back(max_packable<T, Scheme>());
+    }
+}
+
+/**
+ * @tparam T Type of the integers.
+ * @return Upper bounds of the code classes for all schemes in `all_scheme_ids`, sorted and deduplicated.
+ *
+ * Each interval between consecutive bounds lies inside a single code class for every scheme,
+ * so a histogram over these intervals is sufficient to compute the exact cost of each literal under each scheme.
+ */
+template<typename T>
+std::vector<T> scheme_class_bounds() {
+    std::vector<T> output;
+    for (auto id : all_scheme_ids) {
+        dispatch_scheme(id, [&](auto scheme) -> void {
+            append_class_bounds<T, decltype(scheme)>(output);
+        });
+    }
+    std::sort(output.begin(), output.end());
+    output.erase(std::unique(output.begin(), output.end()), output.end());
+    return output;
+}
+
+/**
+ * @tparam rle Whether to use run-length encoding.
+ * @tparam T Type of the integers.
+ *
+ * @param n Number of integers.
+ * @param input Pointer to an array of length `n`, containing the integers to be packed.
+ *
+ * @return The scheme that is expected to give the smallest output for `input`.
+ *
+ * This builds a histogram of runs over the intervals from `scheme_class_bounds()`, from which the cost of all literals can be computed for each scheme.
+ * For runs that might be run-length encoded, the cost of the RLE marker and length is compared to that of the repeated literals, assuming 4 bits of padding on average.
+ * Schemes that cannot represent the largest integer in `input` with type `T`, as determined by `max_packable()`, are not considered.
+ * If no scheme is suitable, `SchemeId::DOUBLING_1` is returned, consistent with the default for `pack_psip()`.
+ */
+template<bool rle = true, typename T>
+SchemeId choose_scheme(size_t n, const T* input) {
+    static const std::vector<T> bounds = scheme_class_bounds<T>();
+    std::vector<size_t> histogram(bounds.size() + 1);
+    std::vector<std::pair<size_t, size_t> > runs; // (bucket, run length) for runs longer than 1.
+
+    size_t i = 0;
+    while (i < n) {
+        auto val = input[i];
+        auto copy = i + count_run(n - i, input + i);
+
+        size_t bucket = std::lower_bound(bounds.begin(), bounds.end(), val) - bounds.begin();
+        size_t len = copy - i;
+        if constexpr(rle) {
+            ++histogram[bucket];
+            if (len > 1) {
+                runs.emplace_back(bucket, len);
+            }
+        } else {
+            histogram[bucket] += len;
+        }
+        i = copy;
+    }
+
+    SchemeId best = SchemeId::DOUBLING_1;
+    size_t best_cost = std::numeric_limits<size_t>::max();
+
+    for (auto id : all_scheme_ids) {
+        size_t cost = dispatch_scheme(id, [&](auto scheme) -> size_t {
+            typedef decltype(scheme) Scheme;
+            constexpr size_t infeasible = std::numeric_limits<size_t>::max();
+            T limit = max_packable<T, Scheme>();
+
+            std::vector<int> widths(bounds.size());
+            size_t total = 0;
+            for (size_t b = 0; b < bounds.size(); ++b) {
+                if (bounds[b] <= limit) {
+                    widths[b] = code_width<Scheme>(bounds[b]);
+                    total += histogram[b] * widths[b];
+                } else if (histogram[b]) {
+                    return infeasible;
+                }
+            }
+            if (histogram.back()) {
+                return infeasible;
+            }
+
+            for (const auto& r : runs) {
+                size_t naive = widths[r.first] * (r.second - 1);
+                size_t encoded = 4 + 8 + code_width<Scheme>(r.second);
+                total += std::min(naive, encoded);
+            }
+
+            return total;
+        });
+
+        if (cost < best_cost) {
+            best_cost = cost;
+            best = id;
+        }
+    }
+
+    return best;
+}
+
+/**
+ * @tparam rle Whether to use run-length encoding.
+ * @tparam T Type of the integers to be packed.
+ *
+ * @param n Number of integers to be packed.
+ * @param input Pointer to an array of length `n`, containing the integers to be packed.
+ * @param block_size Number of integers in each block, see `choose_block_boundaries()` for details.
+ * @param nthreads Number of threads to use.
+ *
+ * @return A block-structured stream, see `BlockTable` for details.
+ * Each block starts with a single byte containing the `SchemeId` chosen by `choose_scheme()`,
+ * followed by the output of `pack_psip()` for that scheme.
+ */
+template<bool rle = true, typename T>
+std::vector<uint8_t> pack_psip_adaptive(size_t n, const T* input, size_t block_size = 65536, int nthreads = 1) {
+    auto boundaries = choose_block_boundaries<rle>(n, input, block_size);
+    size_t nblocks = boundaries.size() - 1;
+
+    std::vector<std::vector<uint8_t> > packed(nblocks);
+    parallelize(nblocks, nthreads, [&](size_t b) -> void {
+        size_t len = boundaries[b + 1] - boundaries[b];
+        auto ptr = input + boundaries[b];
+        auto id = choose_scheme<rle>(len, ptr);
+
+        auto& current = packed[b];
+        current.reserve(len / 10 + 1);
+        current.push_back(static_cast<uint8_t>(id));
+        dispatch_scheme(id, [&](auto scheme) -> void {
+            pack_psip_append<rle, decltype(scheme)>(len, ptr, current);
+        });
+    });
+
+    return concatenate_blocks(boundaries, packed);
+}
+
+}
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef SPACKER_PACK_BLOCKED_HPP
+#define SPACKER_PACK_BLOCKED_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+#include "Doubling.hpp"
+#include "pack_psip.hpp"
+#include "BlockTable.hpp"
+#include "parallelize.hpp"
+
+/**
+ * @file pack_psip_blocked.hpp
+ *
+ * @brief Pack independent blocks in parallel.
+ */
+
+namespace spacker {
+
+/**
+ * @tparam rle Whether to use run-length encoding.
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ *
+ * @param n Number of integers to be packed.
+ * @param input Pointer to an array of length `n`, containing the integers to be packed.
+ * @param block_size Number of integers in each block.
+ *
+ * @return Position of the start of each block, plus `n` as the last entry.
+ *
+ * If `rle = true`, a boundary that falls inside a run is moved to the end of that run, so that the run is not split across blocks.
+ * This is only done if the run ends before the next boundary; longer runs are split, as the cost of a split is negligible compared to a block-sized run.
+ */
+template<bool rle = true, typename T>
+std::vector<size_t> choose_block_boundaries(size_t n, const T* input, size_t block_size) {
+    block_size = std::max(block_size, static_cast<size_t>(1));
+    std::vector<size_t> boundaries{ 0 };
+
+    while (boundaries.back() < n) {
+        size_t next = std::min(n, boundaries.back() + block_size);
+
+        if constexpr(rle) {
+            if (next < n) {
+                size_t limit = std::min(n, next + block_size);
+                size_t snapped = next;
+                while (snapped < limit && input[snapped] == input[snapped - 1]) {
+                    ++snapped;
+                }
+                if (snapped < limit || snapped == n) {
+                    next = snapped;
+                }
+            }
+        }
+
+        boundaries.push_back(next);
+    }
+
+    return boundaries;
+}
+
+/**
+ * @param boundaries Position of the start of each block, plus the total number of integers as the last entry.
+ * @param packed Packed bytes for each block.
+ * This is cleared on return.
+ *
+ * @return A block-structured stream containing all blocks, see `BlockTable` for details.
+ */
+inline std::vector<uint8_t> concatenate_blocks(const std::vector<size_t>& boundaries, std::vector<std::vector<uint8_t> >& packed) {
+    size_t nblocks = packed.size();
+    std::vector<size_t> nbytes(nblocks), nints(nblocks);
+    size_t total = block_header_size(nblocks);
+    for (size_t b = 0; b < nblocks; ++b) {
+        nbytes[b] = packed[b].size();
+        nints[b] = boundaries[b + 1] - boundaries[b];
+        total += nbytes[b];
+    }
+
+    std::vector<uint8_t> output(total);
+    write_block_header(nbytes, nints, output.data());
+    auto ptr = output.data() + block_header_size(nblocks);
+    for (auto& p : packed) {
+        std::copy(p.begin(), p.end(), ptr);
+        ptr += p.size();
+        std::vector<uint8_t>().swap(p);
+    }
+
+    return output;
+}
+
+/**
+ * @tparam rle Whether to use run-length encoding.
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam T Type of the integers to be packed.
+ *
+ * @param n Number of integers to be packed.
+ * @param input Pointer to an array of length `n`, containing the integers to be packed.
+ * @param block_size Number of integers in each block, see `choose_block_boundaries()` for details.
+ * @param nthreads Number of threads to use.
+ *
+ * @return A block-structured stream, see `BlockTable` for details.
+ * Each block is packed independently with `pack_psip()`, so its bytes are identical to those from a serial call on the same integers.
+ * The stream always starts with the block header, even if there is only one block;
+ * this is required by `unpack_psip_parallel()`, and callers that want the plain `pack_psip()` format should call it directly.
+ */
+template<bool rle = true, class Scheme = Doubling<>, typename T>
+std::vector<uint8_t> pack_psip_blocked(size_t n, const T* input, size_t block_size = 65536, int nthreads = 1) {
+    auto boundaries = choose_block_boundaries<rle>(n, input, block_size);
+    size_t nblocks = boundaries.size() - 1;
+
+    std::vector<std::vector<uint8_t> > packed(nblocks);
+    parallelize(nblocks, nthreads, [&](size_t b) -> void {
+        packed[b] = pack_psip<rle, Scheme>(boundaries[b + 1] - boundaries[b], input + boundaries[b]);
+    });
+
+    return concatenate_blocks(boundaries, packed);
+}
+
+}
+
+#endif
\ No newline at end of file
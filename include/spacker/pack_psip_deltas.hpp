@@ -0,0 +1,105 @@
+#ifndef SPACKER_PACK_DELTAS_HPP
+#define SPACKER_PACK_DELTAS_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Doubling.hpp"
+#include "pack_psip.hpp"
+
+/**
+ * @file pack_psip_deltas.hpp
+ *
+ * @brief Pack strictly increasing integers as their differences.
+ */
+
+namespace spacker {
+
+template<bool rle, class Scheme, typename T, class Output>
+void pack_psip_deltas_internal(size_t n, const T* input, Output& output) {
+    // Deltas are computed with an origin of -1, so we shift everything up by 1.
+    // Using unsigned integers also avoids problems with signed input.
+    typedef typename std::make_unsigned<T>::type Delta;
+    auto shifted = [&](size_t i) -> Delta {
+        return static_cast<Delta>(static_cast<Delta>(input[i]) + 1);
+    };
+
+    BitWriter writer;
+
+    Delta previous = 0;
+    size_t i = 0;
+    while (i < n) {
+        Delta current = shifted(i);
+        if (current <= previous) {
+            throw std::runtime_error("integers should be non-negative and strictly increasing");
+        }
+        Delta val = current - previous;
+        previous = current;
+        ++i;
+
+        if constexpr(rle) {
+            // Stretches of consecutive integers become runs of 1's, and so on.
+            size_t count = 1;
+            while (i < n) {
+                Delta next = shifted(i);
+                if (next <= previous || next - previous != val) {
+                    break; // invalid values are caught in the next iteration of the outer loop.
+                }
+                previous = next;
+                ++count;
+                ++i;
+            }
+            pack_psip_run<rle, Scheme>(val, count, writer, output);
+        } else {
+            pack_psip_inner<Scheme>(val, writer, output);
+        }
+    }
+
+    pack_psip_finish(writer, output);
+}
+
+/**
+ * @tparam rle Whether to use run-length encoding.
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam T Type of the integers to be packed.
+ * @tparam Output Container of bytes, see `pack_psip()`.
+ *
+ * @param n Number of integers to be packed.
+ * @param input Pointer to an array of length `n`, containing non-negative and strictly increasing integers, e.g., sorted indices.
+ * These should be less than the maximum value of `T`.
+ *
+ * @return Packed bytes.
+ * This is equivalent to calling `pack_psip()` on the differences between consecutive integers, where the first difference is `input[0] + 1`.
+ * The differences are computed on the fly, so no temporary array is required.
+ * A `std::runtime_error` is thrown if `input` is not strictly increasing.
+ */
+template<bool rle = true, class Scheme = Doubling<>, typename T, class Output = std::vector<uint8_t> >
+Output pack_psip_deltas(size_t n, const T* input) {
+    Output output;
+    output.reserve(n/10);
+    pack_psip_deltas_internal<rle, Scheme>(n, input, output);
+    return output;
+}
+
+/**
+ * @tparam rle Whether to use run-length encoding.
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam T Type of the integers to be packed.
+ * @tparam Output Container of bytes that supports `push_back()`.
+ *
+ * @param n Number of integers to be packed.
+ * @param input Pointer to an array of length `n`, containing non-negative and strictly increasing integers.
+ * @param output Container to which the packed bytes are appended.
+ * These are identical to the bytes returned by `pack_psip_deltas()`.
+ */
+template<bool rle = true, class Scheme = Doubling<>, typename T, class Output>
+void pack_psip_deltas_append(size_t n, const T* input, Output& output) {
+    pack_psip_deltas_internal<rle, Scheme>(n, input, output);
+}
+
+}
+
+#endif
@@ -0,0 +1,153 @@
+#ifndef SPACKER_PACK_OPTIMAL_HPP
+#define SPACKER_PACK_OPTIMAL_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <array>
+#include <limits>
+#include <algorithm>
+
+#include "Doubling.hpp"
+#include "BitWriter.hpp"
+#include "pack_psip.hpp"
+#include "simd.hpp"
+
+/**
+ * @file pack_psip_optimal.hpp
+ *
+ * @brief Pack integers with optimal RLE decisions.
+ */
+
+namespace spacker {
+
+struct OptimalChoice {
+    uint8_t previous = 0; // bit offset before the run.
+    bool rle = false;
+    uint8_t before = 0; // literals before the RLE marker, including the repeated literal.
+    uint8_t after = 0; // literals after the RLE length.
+};
+
+template<class Scheme, typename T, class Output>
+void pack_psip_optimal_internal(size_t n, const T* input, size_t block_runs, Output& output) {
+    constexpr int width = 8;
+    constexpr size_t unreachable = std::numeric_limits<size_t>::max();
+    block_runs = std::max(block_runs, static_cast<size_t>(1));
+
+    BitWriter writer;
+    std::vector<std::pair<T, size_t> > runs;
+    std::vector<std::array<OptimalChoice, width> > choices;
+    std::vector<OptimalChoice> path;
+
+    size_t i = 0;
+    while (i < n) {
+        runs.clear();
+        while (i < n && runs.size() < block_runs) {
+            size_t len = count_run(n - i, input + i);
+            runs.emplace_back(input[i], len);
+            i += len;
+        }
+
+        // Forward pass, computing the smallest number of bits to reach each bit offset (modulo 8) after each run.
+        std::array<size_t, width> cost;
+        cost.fill(unreachable);
+        cost[writer.pending() % width] = 0;
+        choices.resize(runs.size());
+
+        for (size_t r = 0; r < runs.size(); ++r) {
+            std::array<size_t, width> next;
+            next.fill(unreachable);
+            auto& current = choices[r];
+
+            size_t code = code_width<Scheme>(runs[r].first);
+            size_t len = runs[r].second;
+            auto update = [&](size_t offset, size_t total, const OptimalChoice& choice) -> void {
+                offset %= width;
+                if (total < next[offset]) {
+                    next[offset] = total;
+                    current[offset] = choice;
+                }
+            };
+
+            for (int s = 0; s < width; ++s) {
+                if (cost[s] == unreachable) {
+                    continue;
+                }
+
+                OptimalChoice choice;
+                choice.previous = s;
+                update(s + len * code, cost[s] + len * code, choice);
+
+                // Only the number of literals before and after the RLE modulo 8 affects the alignment,
+                // so there is no need to consider more than 8 of each.
+                choice.rle = true;
+                for (size_t before = 1; before <= width && before + 1 <= len; ++before) {
+                    size_t padding = (width - (s + before * code) % width) % width;
+                    for (size_t after = 0; after < width && before + after + 1 <= len; ++after) {
+                        size_t count = len - before - after + 1;
+                        size_t count_code = code_width<Scheme>(count);
+                        size_t total = cost[s] + (before + after) * code + padding + width + count_code;
+                        choice.before = before;
+                        choice.after = after;
+                        update(count_code + after * code, total, choice);
+                    }
+                }
+            }
+
+            cost = next;
+        }
+
+        // Backtracking from the cheapest final offset.
+        int offset = std::min_element(cost.begin(), cost.end()) - cost.begin();
+        path.resize(runs.size());
+        for (size_t r = runs.size(); r > 0; --r) {
+            path[r - 1] = choices[r - 1][offset];
+            offset = path[r - 1].previous;
+        }
+
+        for (size_t r = 0; r < runs.size(); ++r) {
+            auto val = runs[r].first;
+            size_t len = runs[r].second;
+            int code = code_width<Scheme>(val);
+            const auto& choice = path[r];
+            if (choice.rle) {
+                pack_psip_repeat<Scheme>(val, code, choice.before, writer, output);
+                pack_psip_rle<Scheme>(len - choice.before - choice.after + 1, writer, output);
+                pack_psip_repeat<Scheme>(val, code, choice.after, writer, output);
+            } else {
+                pack_psip_repeat<Scheme>(val, code, len, writer, output);
+            }
+        }
+    }
+
+    pack_psip_finish(writer, output);
+}
+
+/**
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam T Type of the integers to be packed.
+ * @tparam Output Container of bytes, see `pack_psip()`.
+ *
+ * @param n Number of integers to be packed.
+ * @param input Pointer to an array of length `n`, containing the integers to be packed.
+ * @param block_runs Number of runs in each block for the dynamic programming.
+ *
+ * @return Packed bytes, which can be unpacked by `unpack_psip()`.
+ *
+ * `pack_psip()` decides whether to use RLE for each run based on the current padding,
+ * without considering how the choice affects the alignment of subsequent runs.
+ * Here, the input is split into blocks of runs, and dynamic programming over the bit offset (modulo 8) after each run is used to find the smallest encoding of each block.
+ * Each run can be encoded as literals or with RLE, where the latter may be preceded or followed by a few literals to adjust the alignment.
+ * The encoding of each block is never larger than that chosen by `pack_psip()` from the same starting offset, at the cost of slower packing.
+ */
+template<class Scheme = Doubling<>, typename T, class Output = std::vector<uint8_t> >
+Output pack_psip_optimal(size_t n, const T* input, size_t block_runs = 65536) {
+    Output output;
+    output.reserve(n/10);
+    pack_psip_optimal_internal<Scheme>(n, input, block_runs, output);
+    return output;
+}
+
+}
+
+#endif
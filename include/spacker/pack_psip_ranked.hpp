@@ -0,0 +1,157 @@
+#ifndef SPACKER_PACK_RANKED_HPP
+#define SPACKER_PACK_RANKED_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+
+#include "Doubling.hpp"
+#include "pack_psip.hpp"
+#include "simd.hpp"
+
+/**
+ * @file pack_psip_ranked.hpp
+ *
+ * @brief Pack integers after remapping them to their frequency ranks.
+ */
+
+namespace spacker {
+
+template<typename T>
+bool use_dense_histogram(T largest, size_t n) {
+    // Dense arrays are only used if they are not much larger than the input.
+    constexpr uint64_t dense_limit = 65536;
+    return static_cast<uint64_t>(largest) <= std::max(static_cast<uint64_t>(n), dense_limit);
+}
+
+/**
+ * @tparam T Type of the integers.
+ *
+ * @param n Number of integers.
+ * @param input Pointer to an array of length `n`, containing positive integers.
+ *
+ * @return Distinct values of `input`, sorted by decreasing frequency.
+ * Ties are broken by increasing value.
+ */
+template<typename T>
+std::vector<T> rank_by_frequency(size_t n, const T* input) {
+    std::vector<std::pair<size_t, T> > counts;
+
+    T largest = 0;
+    for (size_t i = 0; i < n; ++i) {
+        largest = std::max(largest, input[i]);
+    }
+
+    // Using a dense histogram if the values are small enough; otherwise, a hash map.
+    if (use_dense_histogram(largest, n)) {
+        std::vector<size_t> histogram(static_cast<size_t>(largest) + 1);
+        for (size_t i = 0; i < n; ++i) {
+            ++histogram[input[i]];
+        }
+        for (size_t v = 0; v < histogram.size(); ++v) {
+            if (histogram[v]) {
+                counts.emplace_back(histogram[v], static_cast<T>(v));
+            }
+        }
+    } else {
+        std::unordered_map<T, size_t> histogram;
+        for (size_t i = 0; i < n; ++i) {
+            ++histogram[input[i]];
+        }
+        counts.reserve(histogram.size());
+        for (const auto& h : histogram) {
+            counts.emplace_back(h.second, h.first);
+        }
+    }
+
+    std::sort(counts.begin(), counts.end(), [](const std::pair<size_t, T>& left, const std::pair<size_t, T>& right) -> bool {
+        if (left.first != right.first) {
+            return left.first > right.first;
+        }
+        return left.second < right.second;
+    });
+
+    std::vector<T> output;
+    output.reserve(counts.size());
+    for (const auto& c : counts) {
+        output.push_back(c.second);
+    }
+    return output;
+}
+
+template<bool rle, class Scheme, typename T, class Output>
+void pack_psip_ranked_internal(size_t n, const T* input, Output& output) {
+    if (n == 0) {
+        return;
+    }
+
+    BitWriter writer;
+
+    // The dictionary is stored at the start of the stream, as its length followed by the values in order of rank.
+    auto dictionary = rank_by_frequency(n, input);
+    pack_psip_inner<Scheme>(static_cast<T>(dictionary.size()), writer, output);
+    for (auto d : dictionary) {
+        pack_psip_inner<Scheme>(d, writer, output);
+    }
+
+    std::unordered_map<T, T> sparse_ranks;
+    std::vector<T> dense_ranks;
+    T largest = *std::max_element(dictionary.begin(), dictionary.end());
+    bool dense = use_dense_histogram(largest, n);
+    if (dense) {
+        dense_ranks.resize(static_cast<size_t>(largest) + 1);
+        for (size_t r = 0; r < dictionary.size(); ++r) {
+            dense_ranks[dictionary[r]] = r + 1;
+        }
+    } else {
+        sparse_ranks.reserve(dictionary.size());
+        for (size_t r = 0; r < dictionary.size(); ++r) {
+            sparse_ranks[dictionary[r]] = r + 1;
+        }
+    }
+
+    size_t i = 0;
+    while (i < n) {
+        auto val = input[i];
+        T rank = (dense ? dense_ranks[val] : sparse_ranks[val]);
+        if constexpr(rle) {
+            auto copy = i + count_run(n - i, input + i);
+            pack_psip_run<rle, Scheme>(rank, copy - i, writer, output);
+            i = copy;
+        } else {
+            pack_psip_inner<Scheme>(rank, writer, output);
+            ++i;
+        }
+    }
+
+    pack_psip_finish(writer, output);
+}
+
+/**
+ * @tparam rle Whether to use run-length encoding.
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam T Type of the integers to be packed.
+ * @tparam Output Container of bytes, see `pack_psip()`.
+ *
+ * @param n Number of integers to be packed.
+ * @param input Pointer to an array of length `n`, containing the integers to be packed.
+ *
+ * @return Packed bytes.
+ *
+ * Each integer is replaced by the rank of its frequency, so that the most frequent integer is packed as 1, the second most frequent as 2, and so on.
+ * This satisfies the assumption of monotonically decreasing frequencies, even if the original integers do not, e.g., Poisson counts with a large mean.
+ * The dictionary of distinct values is stored at the start of the stream, and the entire stream can still be read by `unpack_psip()`.
+ */
+template<bool rle = true, class Scheme = Doubling<>, typename T, class Output = std::vector<uint8_t> >
+Output pack_psip_ranked(size_t n, const T* input) {
+    Output output;
+    output.reserve(n/10);
+    pack_psip_ranked_internal<rle, Scheme>(n, input, output);
+    return output;
+}
+
+}
+
+#endif
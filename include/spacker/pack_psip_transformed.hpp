@@ -0,0 +1,101 @@
+#ifndef SPACKER_PACK_TRANSFORMED_HPP
+#define SPACKER_PACK_TRANSFORMED_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include "Doubling.hpp"
+#include "Zigzag.hpp"
+#include "Offset.hpp"
+#include "pack_psip.hpp"
+#include "simd.hpp"
+
+/**
+ * @file pack_psip_transformed.hpp
+ *
+ * @brief Pack zeros and signed integers by transforming them into positive codes.
+ */
+
+namespace spacker {
+
+template<bool rle, class Scheme, typename T, class Transform, class Output>
+void pack_psip_transformed_internal(size_t n, const T* input, const Transform& transform, Output& output) {
+    BitWriter writer;
+
+    size_t i = 0;
+    while (i < n) {
+        auto val = input[i];
+        uint64_t code = transform.forward(val);
+        if constexpr(rle) {
+            // Transforms are bijective, so runs of codes are the same as runs of integers.
+            auto copy = i + count_run(n - i, input + i);
+            pack_psip_run<rle, Scheme>(code, copy - i, writer, output);
+            i = copy;
+        } else {
+            pack_psip_inner<Scheme>(code, writer, output);
+            ++i;
+        }
+    }
+
+    pack_psip_finish(writer, output);
+}
+
+/**
+ * @tparam rle Whether to use run-length encoding.
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam T Type of the integers to be packed.
+ * @tparam Transform Class with a `forward()` method that maps each integer to a positive `uint64_t` code, e.g., `Zigzag`, `Offset`.
+ * @tparam Output Container of bytes, see `pack_psip()`.
+ *
+ * @param n Number of integers to be packed.
+ * @param input Pointer to an array of length `n`, containing the integers to be packed.
+ * @param transform Instance of the transform.
+ *
+ * @return Packed bytes, equivalent to calling `pack_psip()` on the codes.
+ * The codes are computed on the fly, so no temporary array is required.
+ */
+template<bool rle = true, class Scheme = Doubling<>, typename T, class Transform, class Output = std::vector<uint8_t> >
+Output pack_psip_transformed(size_t n, const T* input, const Transform& transform) {
+    Output output;
+    output.reserve(n/10);
+    pack_psip_transformed_internal<rle, Scheme>(n, input, transform, output);
+    return output;
+}
+
+/**
+ * @tparam rle Whether to use run-length encoding.
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam T Signed integer type.
+ * @tparam Output Container of bytes, see `pack_psip()`.
+ *
+ * @param n Number of integers to be packed.
+ * @param input Pointer to an array of length `n`, containing the integers to be packed.
+ *
+ * @return Packed bytes, after applying the `Zigzag` transform to each integer.
+ */
+template<bool rle = true, class Scheme = Doubling<>, typename T, class Output = std::vector<uint8_t> >
+Output pack_psip_zigzag(size_t n, const T* input) {
+    return pack_psip_transformed<rle, Scheme, T, Zigzag<T>, Output>(n, input, Zigzag<T>());
+}
+
+/**
+ * @tparam rle Whether to use run-length encoding.
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam T Integer type.
+ * @tparam Output Container of bytes, see `pack_psip()`.
+ *
+ * @param n Number of integers to be packed.
+ * @param input Pointer to an array of length `n`, containing the integers to be packed.
+ * @param offset Lower bound on all integers in `input`, e.g., 0 for data containing zeros.
+ *
+ * @return Packed bytes, after applying the `Offset` transform to each integer.
+ */
+template<bool rle = true, class Scheme = Doubling<>, typename T, class Output = std::vector<uint8_t> >
+Output pack_psip_offset(size_t n, const T* input, T offset) {
+    return pack_psip_transformed<rle, Scheme, T, Offset<T>, Output>(n, input, Offset<T>(offset));
+}
+
+}
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef SPACKER_PARALLELIZE_HPP
+#define SPACKER_PARALLELIZE_HPP
+
+#include <cstddef>
+
+#ifndef SPACKER_CUSTOM_PARALLEL
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <exception>
+#include <algorithm>
+#endif
+
+/**
+ * @file parallelize.hpp
+ *
+ * @brief Run tasks on multiple threads.
+ */
+
+namespace spacker {
+
+/**
+ * @tparam Function Function to be called with the index of a task.
+ *
+ * @param ntasks Number of tasks.
+ * @param nthreads Number of threads.
+ * @param fun Function to execute each task.
+ *
+ * Tasks are handed out to threads one at a time, so threads that finish cheap tasks will pick up the remaining work.
+ * This can be overridden by defining a `SPACKER_CUSTOM_PARALLEL` function-like macro with the same arguments,
+ * e.g., to use an existing thread pool in the calling application.
+ * Otherwise, the calling application should link to a threading library, e.g., `Threads::Threads` in CMake.
+ */
+template<class Function>
+void parallelize(size_t ntasks, int nthreads, Function fun) {
+#ifdef SPACKER_CUSTOM_PARALLEL
+    SPACKER_CUSTOM_PARALLEL(ntasks, nthreads, fun);
+#else
+    size_t nworkers = std::min(static_cast<size_t>(std::max(nthreads, 1)), ntasks);
+    if (nworkers <= 1) {
+        for (size_t t = 0; t < ntasks; ++t) {
+            fun(t);
+        }
+        return;
+    }
+
+    std::atomic<size_t> next(0);
+    std::vector<std::exception_ptr> errors(nworkers);
+    auto work = [&](size_t w) -> void {
+        try {
+            size_t t;
+            while ((t = next.fetch_add(1)) < ntasks) {
+                fun(t);
+            }
+        } catch (...) {
+            errors[w] = std::current_exception();
+            next = ntasks; // stop handing out tasks.
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(nworkers - 1);
+    for (size_t w = 1; w < nworkers; ++w) {
+        workers.emplace_back(work, w);
+    }
+    work(0);
+
+    for (auto& w : workers) {
+        w.join();
+    }
+    for (auto& e : errors) {
+        if (e) {
+            std::rethrow_exception(e);
+        }
+    }
+#endif
+}
+
+}
+
+#endif
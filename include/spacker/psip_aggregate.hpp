@@ -0,0 +1,176 @@
+#ifndef SPACKER_PSIP_AGGREGATE_HPP
+#define SPACKER_PSIP_AGGREGATE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <type_traits>
+
+#include "Doubling.hpp"
+#include "unpack_psip.hpp"
+#include "simd.hpp"
+
+/**
+ * @file psip_aggregate.hpp
+ *
+ * @brief Compute summaries of packed integers without unpacking them.
+ */
+
+namespace spacker {
+
+template<class Scheme, class Run>
+void psip_visit_runs(size_t ni, const uint8_t* input, size_t no, Run run) {
+    // Decoding to 64-bit integers is exact for streams packed with any type.
+    ByteDecoder<Scheme, uint64_t> decoder;
+    uint64_t last = 0;
+
+    auto value = [&](uint64_t val) -> void {
+        if (no) {
+            run(val, 1);
+            last = val;
+            --no;
+        }
+    };
+
+    auto repeat = [&](size_t extra) -> void {
+        extra = std::min(extra, no);
+        if (extra) {
+            run(last, extra);
+            no -= extra;
+        }
+    };
+
+    size_t i = 0;
+    while (i < ni && no) {
+        if constexpr(std::is_same<Scheme, Doubling<1> >::value) {
+            // Fast path for stretches of bytes containing only 1's and 2's, where each set bit is the preamble of a 2.
+            // Each byte contains at most 8 integers, so we can process up to no/8 bytes without overshooting.
+            if (decoder.fresh() && is_short_code_byte(input[i]) && no >= 8) {
+                size_t len = count_short_code_bytes(std::min(ni - i, no / 8), input + i);
+                SPACKER_DECODE_COUNT(short_code_bytes, len);
+                size_t twos = count_set_bits(len, input + i);
+                size_t ones = len * 8 - 2 * twos;
+                if (ones) {
+                    run(1, ones);
+                }
+                if (twos) {
+                    run(2, twos);
+                }
+                no -= ones + twos;
+
+                // The last code in the last byte is needed in case it is followed by an RLE marker.
+                i += len;
+                last = ((input[i - 1] >> 1) & 1) + 1;
+                continue;
+            }
+        }
+
+        decoder.consume(input[i], value, repeat);
+        ++i;
+    }
+}
+
+/**
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ *
+ * @param ni Number of bytes in the packed input.
+ * @param input Pointer to the packed input, created by `pack_psip()`.
+ * @param no Number of integers in the packed input.
+ *
+ * @return Sum of all integers, wrapping around on overflow.
+ * RLE runs contribute their value multiplied by their length, without being expanded.
+ */
+template<class Scheme = Doubling<> >
+uint64_t psip_sum(size_t ni, const uint8_t* input, size_t no) {
+    uint64_t total = 0;
+    psip_visit_runs<Scheme>(ni, input, no, [&](uint64_t val, size_t count) -> void {
+        total += val * count;
+    });
+    return total;
+}
+
+/**
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ *
+ * @param ni Number of bytes in the packed input.
+ * @param input Pointer to the packed input, created by `pack_psip()`.
+ * @param no Number of integers in the packed input.
+ *
+ * @return Largest integer, or zero if there are no integers.
+ */
+template<class Scheme = Doubling<> >
+uint64_t psip_max(size_t ni, const uint8_t* input, size_t no) {
+    uint64_t best = 0;
+    psip_visit_runs<Scheme>(ni, input, no, [&](uint64_t val, size_t) -> void {
+        best = std::max(best, val);
+    });
+    return best;
+}
+
+/**
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ *
+ * @param ni Number of bytes in the packed input.
+ * @param input Pointer to the packed input, created by `pack_psip()`.
+ * @param no Number of integers in the packed input.
+ * @param target Integer to be counted, e.g., 1 to count the number of ones.
+ *
+ * @return Number of integers equal to `target`.
+ */
+template<class Scheme = Doubling<> >
+size_t psip_count_equal(size_t ni, const uint8_t* input, size_t no, uint64_t target) {
+    size_t total = 0;
+    psip_visit_runs<Scheme>(ni, input, no, [&](uint64_t val, size_t count) -> void {
+        if (val == target) {
+            total += count;
+        }
+    });
+    return total;
+}
+
+/**
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ *
+ * @param ni Number of bytes in the packed input.
+ * @param input Pointer to the packed input, created by `pack_psip()`.
+ * @param no Number of integers in the packed input.
+ *
+ * @return Pairs of distinct integers and their frequencies, sorted by increasing integer.
+ * This can be used directly in `train_table_widths()`.
+ */
+template<class Scheme = Doubling<> >
+std::vector<std::pair<uint64_t, size_t> > psip_histogram(size_t ni, const uint8_t* input, size_t no) {
+    // Small integers are counted in a dense array, and the rest in a hash map.
+    constexpr uint64_t dense_limit = 65536;
+    std::vector<size_t> dense;
+    std::unordered_map<uint64_t, size_t> sparse;
+
+    psip_visit_runs<Scheme>(ni, input, no, [&](uint64_t val, size_t count) -> void {
+        if (val < dense_limit) {
+            if (val >= dense.size()) {
+                dense.resize(std::min(std::max(static_cast<size_t>(val + 1), dense.size() * 2), static_cast<size_t>(dense_limit)));
+            }
+            dense[val] += count;
+        } else {
+            sparse[val] += count;
+        }
+    });
+
+    std::vector<std::pair<uint64_t, size_t> > output;
+    for (size_t v = 0; v < dense.size(); ++v) {
+        if (dense[v]) {
+            output.emplace_back(v, dense[v]);
+        }
+    }
+
+    size_t nsmall = output.size();
+    output.insert(output.end(), sparse.begin(), sparse.end());
+    std::sort(output.begin() + nsmall, output.end());
+    return output;
+}
+
+}
+
+#endif
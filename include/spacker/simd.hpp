@@ -0,0 +1,341 @@
+#ifndef SPACKER_SIMD_HPP
+#define SPACKER_SIMD_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#include <algorithm>
+
+#if !defined(SPACKER_NO_SIMD) && defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SPACKER_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+/**
+ * @file simd.hpp
+ *
+ * @brief Vectorized kernels with runtime CPU dispatch.
+ *
+ * Kernels are compiled for specific instruction sets via function attributes,
+ * so they can be selected at runtime without requiring any special compilation flags.
+ * Define `SPACKER_NO_SIMD` to always use the scalar fallbacks.
+ */
+
+namespace spacker {
+
+/**
+ * @return Whether the host CPU supports AVX2.
+ */
+inline bool has_avx2() {
+#ifdef SPACKER_X86_DISPATCH
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @return Whether the host CPU supports the `popcnt` instruction.
+ */
+inline bool has_popcnt() {
+#ifdef SPACKER_X86_DISPATCH
+    static const bool supported = __builtin_cpu_supports("popcnt");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @param v A byte of packed input.
+ * @return Whether `v` consists only of complete 1- and 2-bit codes under `Doubling<1>`, i.e., `0` and `10`.
+ * This is true if no two adjacent bits are set and the last bit is not set.
+ * Notably, this is never true for the RLE marker.
+ */
+inline bool is_short_code_byte(uint8_t v) {
+    return (v & ((v >> 1) | 1)) == 0;
+}
+
+inline size_t count_short_code_bytes_scalar(size_t n, const uint8_t* input) {
+    size_t i = 0;
+    while (i < n && is_short_code_byte(input[i])) {
+        ++i;
+    }
+    return i;
+}
+
+#ifdef SPACKER_X86_DISPATCH
+__attribute__((target("avx2")))
+inline size_t count_short_code_bytes_avx2(size_t n, const uint8_t* input) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i low7 = _mm256_set1_epi8(0x7F);
+    const __m256i last = _mm256_set1_epi8(0x01);
+
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+
+        // No 8-bit shifts, so we shift in 16-bit lanes and mask out the bit from the neighboring byte.
+        __m256i neighbors = _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi16(v, 1), low7), last);
+        __m256i ok = _mm256_cmpeq_epi8(_mm256_and_si256(v, neighbors), zero);
+
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(ok));
+        if (mask != 0xFFFFFFFFu) {
+            return i + __builtin_ctz(~mask);
+        }
+    }
+
+    return i + count_short_code_bytes_scalar(n - i, input + i);
+}
+#endif
+
+/**
+ * @param n Number of bytes.
+ * @param input Pointer to an array of bytes.
+ * @return Length of the longest prefix of `input` where `is_short_code_byte()` is true for every byte.
+ */
+inline size_t count_short_code_bytes(size_t n, const uint8_t* input) {
+#ifdef SPACKER_X86_DISPATCH
+    if (has_avx2()) {
+        return count_short_code_bytes_avx2(n, input);
+    }
+#endif
+    return count_short_code_bytes_scalar(n, input);
+}
+
+inline int popcount_scalar(uint64_t x) {
+    // Standard SWAR popcount, for use when there is no dedicated instruction.
+    x = x - ((x >> 1) & 0x5555555555555555ull);
+    x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return static_cast<int>((x * 0x0101010101010101ull) >> 56);
+}
+
+inline uint64_t load_word(const uint8_t* ptr) {
+    // Byte order doesn't matter when counting bits.
+    uint64_t output = 0;
+    for (int i = 0; i < 8; ++i) {
+        output |= static_cast<uint64_t>(ptr[i]) << (i * 8);
+    }
+    return output;
+}
+
+inline size_t count_set_bits_scalar(size_t n, const uint8_t* input) {
+    size_t total = 0, i = 0;
+    for (; i + 8 <= n; i += 8) {
+        total += popcount_scalar(load_word(input + i));
+    }
+    for (; i < n; ++i) {
+        total += popcount_scalar(input[i]);
+    }
+    return total;
+}
+
+#ifdef SPACKER_X86_DISPATCH
+__attribute__((target("popcnt")))
+inline size_t count_set_bits_popcnt(size_t n, const uint8_t* input) {
+    size_t total = 0, i = 0;
+    for (; i + 8 <= n; i += 8) {
+        total += __builtin_popcountll(load_word(input + i));
+    }
+    for (; i < n; ++i) {
+        total += __builtin_popcount(input[i]);
+    }
+    return total;
+}
+#endif
+
+/**
+ * @param n Number of bytes.
+ * @param input Pointer to an array of bytes.
+ * @return Total number of set bits in `input`.
+ */
+inline size_t count_set_bits(size_t n, const uint8_t* input) {
+#ifdef SPACKER_X86_DISPATCH
+    if (has_popcnt()) {
+        return count_set_bits_popcnt(n, input);
+    }
+#endif
+    return count_set_bits_scalar(n, input);
+}
+
+template<typename T>
+size_t count_run_scalar(size_t n, const T* input) {
+    size_t i = 1;
+    while (i < n && input[i] == input[0]) {
+        ++i;
+    }
+    return i;
+}
+
+#ifdef SPACKER_X86_DISPATCH
+template<typename T>
+__attribute__((target("avx2")))
+size_t count_run_avx2(size_t n, const T* input) {
+    __m256i target;
+    if constexpr(sizeof(T) == 1) {
+        target = _mm256_set1_epi8(static_cast<char>(input[0]));
+    } else if constexpr(sizeof(T) == 2) {
+        target = _mm256_set1_epi16(static_cast<short>(input[0]));
+    } else if constexpr(sizeof(T) == 4) {
+        target = _mm256_set1_epi32(static_cast<int>(input[0]));
+    } else {
+        target = _mm256_set1_epi64x(static_cast<long long>(input[0]));
+    }
+
+    constexpr size_t step = 32 / sizeof(T);
+    size_t i = 1;
+    for (; i + step <= n; i += step) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+        __m256i eq;
+        if constexpr(sizeof(T) == 1) {
+            eq = _mm256_cmpeq_epi8(v, target);
+        } else if constexpr(sizeof(T) == 2) {
+            eq = _mm256_cmpeq_epi16(v, target);
+        } else if constexpr(sizeof(T) == 4) {
+            eq = _mm256_cmpeq_epi32(v, target);
+        } else {
+            eq = _mm256_cmpeq_epi64(v, target);
+        }
+
+        // Each element sets sizeof(T) bits in the mask, so the first unset bit identifies the first mismatch.
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+        if (mask != 0xFFFFFFFFu) {
+            return i + __builtin_ctz(~mask) / sizeof(T);
+        }
+    }
+
+    // Finishing off from the last matching element, which is a valid start for the scalar loop.
+    return i - 1 + count_run_scalar(n - i + 1, input + i - 1);
+}
+#endif
+
+/**
+ * @tparam T Integer type.
+ * @param n Number of integers, should be positive.
+ * @param input Pointer to an array of `n` integers.
+ * @return Length of the run of integers equal to `input[0]` at the start of `input`.
+ *
+ * The first few integers are checked before any vectorized comparisons, so short runs are cheap to detect.
+ */
+template<typename T>
+size_t count_run(size_t n, const T* input) {
+    // Most runs are short, so it's faster to check the first few integers before trying to vectorize.
+    constexpr size_t short_limit = 8;
+    size_t first = std::min(n, short_limit);
+    size_t i = 1;
+    while (i < first && input[i] == input[0]) {
+        ++i;
+    }
+    if (i < first || i == n) {
+        return i;
+    }
+
+#ifdef SPACKER_X86_DISPATCH
+    if constexpr(std::is_integral<T>::value && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)) {
+        if (has_avx2()) {
+            return count_run_avx2(n, input);
+        }
+    }
+#endif
+    return count_run_scalar(n, input);
+}
+
+template<typename T>
+unsigned find_mismatches_scalar(const T* input, T val) {
+    unsigned mismatch = 0;
+    for (int k = 0; k < 8; ++k) {
+        mismatch |= static_cast<unsigned>(input[k] != val) << k;
+    }
+    return mismatch;
+}
+
+/**
+ * @tparam T Integer type.
+ * @param input Pointer to an array of at least 8 integers.
+ * @param val Integer to be compared to each element of `input`.
+ * @return Bitmask where the `k`-th lowest bit is set if `input[k]` is not equal to `val`, for `k` from 0 to 7.
+ *
+ * This uses SSE2, which is always available on x86-64, so no runtime dispatch is needed for such a short comparison.
+ */
+template<typename T>
+unsigned find_mismatches(const T* input, T val) {
+#ifdef SPACKER_X86_DISPATCH
+    if constexpr(std::is_integral<T>::value) {
+        if constexpr(sizeof(T) == 1) {
+            __m128i eq = _mm_cmpeq_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(input)), _mm_set1_epi8(static_cast<char>(val)));
+            return ~static_cast<unsigned>(_mm_movemask_epi8(eq)) & 0xFFu;
+        } else if constexpr(sizeof(T) == 2) {
+            __m128i eq = _mm_cmpeq_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input)), _mm_set1_epi16(static_cast<short>(val)));
+            return ~static_cast<unsigned>(_mm_movemask_epi8(_mm_packs_epi16(eq, eq))) & 0xFFu;
+        } else if constexpr(sizeof(T) == 4) {
+            __m128i target = _mm_set1_epi32(static_cast<int>(val));
+            __m128i lower = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input)), target);
+            __m128i upper = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + 4)), target);
+            return ~static_cast<unsigned>(_mm_movemask_epi8(_mm_packs_epi16(_mm_packs_epi32(lower, upper), lower))) & 0xFFu;
+        }
+    }
+#endif
+    return find_mismatches_scalar(input, val);
+}
+
+template<typename T>
+T prefix_sum_scalar(size_t n, T* data, T carry) {
+    for (size_t i = 0; i < n; ++i) {
+        carry += data[i];
+        data[i] = carry;
+    }
+    return carry;
+}
+
+#ifdef SPACKER_X86_DISPATCH
+__attribute__((target("avx2")))
+inline uint32_t prefix_sum_avx2(size_t n, uint32_t* data, uint32_t carry) {
+    __m256i running = _mm256_set1_epi32(static_cast<int>(carry));
+    const __m256i last = _mm256_set1_epi32(7);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+
+        // Inclusive scan within each 128-bit lane, and then adding the total of the lower lane to the upper lane.
+        x = _mm256_add_epi32(x, _mm256_slli_si256(x, 4));
+        x = _mm256_add_epi32(x, _mm256_slli_si256(x, 8));
+        __m256i lower = _mm256_permute2x128_si256(x, x, 0x08);
+        x = _mm256_add_epi32(x, _mm256_shuffle_epi32(lower, 0xFF));
+
+        x = _mm256_add_epi32(x, running);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i), x);
+        running = _mm256_permutevar8x32_epi32(x, last);
+    }
+
+    carry = static_cast<uint32_t>(_mm256_cvtsi256_si32(running));
+    return prefix_sum_scalar(n - i, data + i, carry);
+}
+#endif
+
+/**
+ * @tparam T Integer type.
+ * @param n Number of integers.
+ * @param data Pointer to an array of `n` integers, to be replaced with their inclusive prefix sums.
+ * @param carry Value to add to all prefix sums, e.g., the total from a previous call.
+ * @return The last prefix sum, or `carry` if `n = 0`.
+ */
+template<typename T>
+T prefix_sum(size_t n, T* data, T carry) {
+#ifdef SPACKER_X86_DISPATCH
+    if constexpr(std::is_integral<T>::value && sizeof(T) == 4) {
+        if (has_avx2()) {
+            // Wrap-around addition is the same for signed and unsigned integers.
+            typedef typename std::make_unsigned<T>::type U;
+            return static_cast<T>(prefix_sum_avx2(n, reinterpret_cast<uint32_t*>(data), static_cast<U>(carry)));
+        }
+    }
+#endif
+    return prefix_sum_scalar(n, data, carry);
+}
+
+}
+
+#endif
@@ -0,0 +1,206 @@
+#ifndef SPACKER_TRAIN_TABLE_WIDTHS_HPP
+#define SPACKER_TRAIN_TABLE_WIDTHS_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+#include "TableScheme.hpp"
+
+/**
+ * @file train_table_widths.hpp
+ *
+ * @brief Choose code widths for a `TableScheme` from a histogram.
+ */
+
+namespace spacker {
+
+/**
+ * @tparam T Type of the integers.
+ * @param widths Width of the code for each number of preamble bits.
+ * @return Largest integer in each code class, saturating at the maximum value of `T`.
+ *
+ * Classes after the first class that is wider than `T` are never used by `pack_psip()`,
+ * so their bounds are set to that of the preceding class, i.e., they are empty.
+ * The last bound is equal to `table_max_packable()`.
+ */
+template<typename T = uint64_t>
+std::array<uint64_t, 8> table_class_bounds(const std::array<int, 8>& widths) {
+    constexpr int digits = std::numeric_limits<T>::digits;
+    constexpr uint64_t limit = std::numeric_limits<T>::max();
+    std::array<uint64_t, 8> output;
+    uint64_t current = 0;
+    bool used = true;
+    for (int b = 0; b < 8; ++b) {
+        if (used) {
+            int payload = widths[b] - b - 1;
+            uint64_t space = (payload >= digits ? limit : (static_cast<uint64_t>(1) << payload));
+            current = (limit - current < space ? limit : current + space);
+            used = (widths[b] <= digits);
+        }
+        output[b] = current;
+    }
+    return output;
+}
+
+/**
+ * @tparam T Type of the integers.
+ * @param widths Width of the code for each number of preamble bits.
+ * @param histogram Pairs of distinct positive integers and their frequencies, sorted by increasing integer.
+ *
+ * @return Total number of bits required to pack all integers in `histogram` without RLE,
+ * or the maximum value of `size_t` if some integers cannot be represented.
+ */
+template<typename T = uint64_t>
+size_t table_packed_bits(const std::array<int, 8>& widths, const std::vector<std::pair<uint64_t, size_t> >& histogram) {
+    auto bounds = table_class_bounds<T>(widths);
+    size_t total = 0;
+    int b = 0;
+    for (const auto& h : histogram) {
+        while (h.first > bounds[b]) {
+            ++b;
+            if (b == 8) {
+                return std::numeric_limits<size_t>::max();
+            }
+        }
+        total += h.second * static_cast<size_t>(widths[b]);
+    }
+    return total;
+}
+
+/**
+ * @tparam T Type of the integers to be packed.
+ *
+ * @param histogram Pairs of distinct positive integers and their frequencies, sorted by increasing integer.
+ * @param limit Largest integer that should be representable by the table.
+ * Defaults to the largest integer in `histogram`.
+ *
+ * @return Widths for a `TableScheme` that minimize `table_packed_bits()` for `histogram`.
+ * These always satisfy `valid_table_widths()` for `T` and `limit`.
+ *
+ * This performs a local search over the width of each class, starting from the widths of the `Doubling` and `Multiplier` schemes.
+ * The result is never worse than any of the valid starting points, and is usually better for distributions that do not match those schemes.
+ * The width of the last class is always set to the smallest value that can represent `limit`.
+ * Candidates where `limit` exceeds `table_max_packable()` for `T` are rejected, as `pack_psip()` would not be able to encode all integers.
+ * A `std::runtime_error` is thrown if `limit` cannot be represented by any table, i.e., it is greater than the maximum value of `T`.
+ */
+template<typename T = uint64_t>
+std::array<int, 8> train_table_widths(const std::vector<std::pair<uint64_t, size_t> >& histogram, uint64_t limit = 0) {
+    if (!histogram.empty()) {
+        limit = std::max(limit, histogram.back().first);
+    }
+    if (limit > static_cast<uint64_t>(std::numeric_limits<T>::max())) {
+        throw std::runtime_error("limit cannot be represented by the integer type");
+    }
+
+    // Precomputing cumulative frequencies so that each evaluation only needs a binary search per class.
+    std::vector<uint64_t> values;
+    std::vector<size_t> cumulative{ 0 };
+    values.reserve(histogram.size());
+    cumulative.reserve(histogram.size() + 1);
+    for (const auto& h : histogram) {
+        values.push_back(h.first);
+        cumulative.push_back(cumulative.back() + h.second);
+    }
+
+    auto evaluate = [&](const std::array<int, 8>& widths) -> size_t {
+        auto bounds = table_class_bounds<T>(widths);
+        size_t total = 0, previous = 0;
+        for (int b = 0; b < 8; ++b) {
+            size_t current = std::upper_bound(values.begin(), values.end(), bounds[b]) - values.begin();
+            total += (cumulative[current] - cumulative[previous]) * static_cast<size_t>(widths[b]);
+            previous = current;
+        }
+        return total;
+    };
+
+    // Sets the last class to the smallest valid width that covers the limit.
+    // This fails if an earlier class is wider than T and does not cover the limit, as the last class is then never used.
+    auto cover = [&](std::array<int, 8>& widths) -> bool {
+        for (int width = 9; width <= 128; ++width) {
+            widths[7] = width;
+            if (valid_table_widths<T>(widths, static_cast<T>(limit))) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    std::array<std::array<int, 8>, 5> starts{{
+        { 1, 2, 4, 8, 16, 32, 64, 128 },
+        { 2, 4, 8, 16, 32, 64, 128, 128 },
+        { 4, 8, 16, 32, 64, 128, 128, 128 },
+        { 4, 8, 12, 16, 20, 24, 28, 32 },
+        { 8, 16, 24, 32, 40, 48, 56, 64 }
+    }};
+
+    // Doubling<1> always covers any limit for any T, so 'best' is always valid.
+    std::array<int, 8> best = starts[0];
+    size_t best_bits = std::numeric_limits<size_t>::max();
+    for (auto current : starts) {
+        if (!cover(current)) {
+            continue;
+        }
+        auto bits = evaluate(current);
+        if (bits < best_bits) {
+            best = current;
+            best_bits = bits;
+        }
+    }
+
+    bool improved = true;
+    while (improved) {
+        improved = false;
+        for (int b = 0; b < 7; ++b) {
+            for (int w = b + 1; w <= 64 + b; ++w) {
+                auto current = best;
+                current[b] = w;
+                if (!cover(current)) {
+                    continue;
+                }
+                auto bits = evaluate(current);
+                if (bits < best_bits) {
+                    best = current;
+                    best_bits = bits;
+                    improved = true;
+                }
+            }
+        }
+    }
+
+    return best;
+}
+
+/**
+ * @tparam T Type of the integers.
+ *
+ * @param n Number of integers in the sample.
+ * @param sample Pointer to an array of length `n`, containing a sample of the positive integers to be packed.
+ * @param limit Largest integer that should be representable by the table, see the other `train_table_widths()` overload.
+ *
+ * @return Widths for a `TableScheme`, as described in the other `train_table_widths()` overload.
+ * These are guaranteed to represent all integers in `sample` when packed as `T`.
+ */
+template<typename T>
+std::array<int, 8> train_table_widths(size_t n, const T* sample, uint64_t limit = 0) {
+    std::vector<T> sorted(sample, sample + n);
+    std::sort(sorted.begin(), sorted.end());
+
+    std::vector<std::pair<uint64_t, size_t> > histogram;
+    for (auto s : sorted) {
+        if (histogram.empty() || histogram.back().first != static_cast<uint64_t>(s)) {
+            histogram.emplace_back(s, 0);
+        }
+        ++(histogram.back().second);
+    }
+
+    return train_table_widths<T>(histogram, limit);
+}
+
+}
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef SPACKER_UNPACK_CSC_HPP
+#define SPACKER_UNPACK_CSC_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include "Doubling.hpp"
+#include "unpack_psip.hpp"
+#include "unpack_psip_deltas.hpp"
+#include "pack_csc.hpp"
+
+/**
+ * @file unpack_csc.hpp
+ *
+ * @brief Unpack a sparse matrix in compressed sparse column format.
+ */
+
+namespace spacker {
+
+template<class Scheme, typename Code, typename Index, typename Value>
+size_t unpack_csc_column_internal(const PackedCsc& packed, size_t c, Index* i, Value* x, std::vector<Code>& scratch) {
+    size_t len = packed.pointers[c + 1] - packed.pointers[c];
+    scratch.resize(len);
+
+    const auto& voff = packed.value_offsets;
+    unpack_psip<Scheme>(voff[c + 1] - voff[c], packed.values.data() + voff[c], len, scratch.data());
+    for (size_t k = 0; k < len; ++k) {
+        x[k] = static_cast<Value>(scratch[k]);
+    }
+
+    const auto& ioff = packed.index_offsets;
+    unpack_psip_deltas<Scheme>(ioff[c + 1] - ioff[c], packed.indices.data() + ioff[c], len, i);
+
+    return len;
+}
+
+/**
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam Code Integer type used to pack the values, as used in `pack_csc()`.
+ * @tparam Index Type of the row indices.
+ * @tparam Value Type of the values.
+ *
+ * @param packed Packed matrix, created by `pack_csc()`.
+ * @param c Index of the column to unpack.
+ * @param i Pointer to an array of length no less than the number of structural non-zeros in column `c`, to store the row indices.
+ * @param x Pointer to an array of length no less than the number of structural non-zeros in column `c`, to store the values.
+ *
+ * @return Number of structural non-zeros in column `c`.
+ */
+template<class Scheme = Doubling<>, typename Code = uint32_t, typename Index, typename Value>
+size_t unpack_csc_column(const PackedCsc& packed, size_t c, Index* i, Value* x) {
+    std::vector<Code> scratch;
+    return unpack_csc_column_internal<Scheme>(packed, c, i, x, scratch);
+}
+
+/**
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam Code Integer type used to pack the values, as used in `pack_csc()`.
+ * @tparam Pointer Type of the column pointers.
+ * @tparam Index Type of the row indices.
+ * @tparam Value Type of the values.
+ *
+ * @param packed Packed matrix, created by `pack_csc()`.
+ * @param p Pointer to an array of length `packed.ncol + 1`, to store the column pointers.
+ * @param i Pointer to an array of length `packed.pointers.back()`, to store the row indices.
+ * @param x Pointer to an array of length `packed.pointers.back()`, to store the values.
+ */
+template<class Scheme = Doubling<>, typename Code = uint32_t, typename Pointer, typename Index, typename Value>
+void unpack_csc(const PackedCsc& packed, Pointer* p, Index* i, Value* x) {
+    std::vector<Code> scratch;
+    p[0] = 0;
+    for (size_t c = 0; c < packed.ncol; ++c) {
+        size_t start = packed.pointers[c];
+        unpack_csc_column_internal<Scheme>(packed, c, i + start, x + start, scratch);
+        p[c + 1] = static_cast<Pointer>(packed.pointers[c + 1]);
+    }
+}
+
+}
+
+#endif
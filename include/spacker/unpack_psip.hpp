@@ -6,198 +6,247 @@
 #include <limits>
 #include <array>
 #include <algorithm>
+#include <type_traits>
 
 #include "utils.hpp"
 #include "Doubling.hpp"
+#include "TransitionTable.hpp"
+#include "simd.hpp"
+#include "DecodeStats.hpp"
 
 namespace spacker {
 
-template<class Scheme, class Bits, class Buffer>
-inline void unpack_psip_step (int keep, Bits& bits, Buffer& buffer, int& preamble, int& remaining, int& at) {
-    // If preamble = true AND keep = true, we have an extra bit in the
-    // preamble, we increase the remaining count. Otherwise neither
-    // bits nor remaining will change.
-    bits[at] += preamble * keep;
-    Scheme::update_remaining(remaining, preamble * keep);
-
-    // If preamble = false, we left-shift the existing buffer element.
-    // If additionally keep = true, we set the least significant bit.
-    buffer[at] <<= (1 - preamble);
-    buffer[at] |= (1 - preamble) * keep;
-
-    // If preamble = false, we subtract a bit. If we're at the end of
-    // the preamble (i.e., preamble = true and keep = false), we
-    // compute the actual number of remaining bits, by subtracting
-    // the bits used in defining the preamble itself.
-    remaining -= (1 - preamble) + preamble * (1 - keep) * (bits[at] + 1);
-
-    // If keep = false, then the preamble ended (or we we never in it).
-    // If remaining = 0, then we've finished the current integer and
-    // are moving onto the preamble of the next integer. No need to 
-    // worry about this exceeding 1 as remaining > 0 during the preamble. 
-    preamble = preamble * keep + (remaining == 0);
-
-    // If there are no more remaining bits, we must be moving to the
-    // preamble of the next element. In that case, we set remaining = 1
-    // so that later left-shifts or multiplications have an effect.
-    at += (remaining == 0); 
-    remaining += (remaining == 0) * Scheme::init_remaining;
+template<class Scheme, typename T, int bits = 0>
+void fill_baseline(std::array<T, 8>& baseline) {
+    baseline[bits] = min<T, Scheme, bits>();
 
-    return;
+    // Stopping at the first class that is wider than T, as in pack_psip(); later classes are never used.
+    if constexpr(bits < 7 && supports<T, Scheme, bits>()) {
+        fill_baseline<Scheme, T, bits + 1>(baseline);
+    }
 }
 
 template<class Scheme, typename T>
 std::array<T, 8> initialize_baseline() {
     std::array<T, 8> baseline;
     std::fill_n(baseline.data(), baseline.size(), 0);
+    fill_baseline<Scheme, T>(baseline);
+    return baseline;
+}
 
-    baseline[0] = min<T, Scheme, 0>();
+/**
+ * @brief Byte-at-a-time decoder for the positive small integer packer.
+ *
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam T Type of the unpacked integers.
+ *
+ * This uses a `TransitionTable` to process each input byte in a single lookup,
+ * keeping track of the unfinished code between bytes.
+ */
+template<class Scheme, typename T>
+class ByteDecoder {
+public:
+    ByteDecoder() : baseline(initialize_baseline<Scheme, T>()), rle_baseline(initialize_baseline<Scheme, size_t>()) {}
+
+    /**
+     * @param val The next byte of the packed input.
+     * @param value Function to be called with each decoded integer.
+     * @param repeat Function to be called with the number of additional copies of the last decoded integer, for each RLE run.
+     */
+    template<class Value, class Repeat>
+    void consume(uint8_t val, Value& value, Repeat& repeat) {
+        if (remaining >= 8) {
+            // Entire byte is payload.
+            SPACKER_DECODE_COUNT(payload_bytes, 1);
+            acc = (acc << 8) | val;
+            remaining -= 8;
+            if (remaining == 0) {
+                emit(acc, bits, value, repeat);
+                acc = 0;
+                bits = 0;
+            }
+            return;
+        }
 
-    if constexpr(supports<T, Scheme, 0>()) {
-        baseline[1] = min<T, Scheme, 1>();
-    }
+        if (remaining == 0 && val == 0b11111111) {
+            // Rle mode; discarding any padding and extracting the length from subsequent bytes.
+            SPACKER_DECODE_COUNT(rle_marker_bytes, 1);
+            rle = true;
+            bits = 0;
+            return;
+        }
 
-    if constexpr(supports<T, Scheme, 1>()) {
-        baseline[2] = min<T, Scheme, 2>();
-    }
+        SPACKER_DECODE_COUNT(table_bytes, 1);
+        const auto& trans = Table::entries[Table::state(bits, remaining) * 256 + val];
+        if (trans.count) {
+            auto code = trans.codes[0];
+            acc = (acc << trans.head) | ((val >> (code >> 3)) & mask(trans.head));
+            emit(acc, code & 0b111, value, repeat);
+
+            for (int c = 1; c < trans.count; ++c) {
+                code = trans.codes[c];
+                int b = code & 0b111;
+                value(static_cast<T>((val >> (code >> 3)) & mask(Table::payloads[b])) + baseline[b]);
+            }
 
-    if constexpr(supports<T, Scheme, 2>()) {
-        baseline[3] = min<T, Scheme, 3>();
-    }
+            acc = val & mask(trans.tail);
+        } else {
+            acc = (acc << trans.tail) | (val & mask(trans.tail));
+        }
 
-    if constexpr(supports<T, Scheme, 3>()) {
-        baseline[4] = min<T, Scheme, 4>();
+        bits = trans.next_bits;
+        remaining = trans.next_remaining;
     }
 
-    if constexpr(supports<T, Scheme, 4>()) {
-        baseline[5] = min<T, Scheme, 5>();
+    /**
+     * @return Whether the decoder is at the start of a new code,
+     * i.e., all previously consumed bytes have been fully decoded.
+     */
+    bool fresh() const {
+        return remaining == 0 && bits == 0 && !rle;
     }
 
-    if constexpr(supports<T, Scheme, 5>()) {
-        baseline[6] = min<T, Scheme, 6>();
-    }
+private:
+    typedef TransitionTable<Scheme> Table;
 
-    if constexpr(supports<T, Scheme, 6>()) {
-        baseline[7] = min<T, Scheme, 7>();
+    static constexpr uint64_t mask(int n) {
+        return (static_cast<uint64_t>(1) << n) - 1;
     }
 
-    return baseline;
-}
+    template<class Value, class Repeat>
+    void emit(uint64_t payload, int b, Value& value, Repeat& repeat) {
+        if (rle) {
+            size_t len = payload + rle_baseline[b];
+            repeat(len - 1); // extra copies to add, beyond the value already added.
+            rle = false;
+        } else {
+            value(static_cast<T>(payload) + baseline[b]);
+        }
+    }
 
-template<class Scheme = Doubling<>, typename T>
-void unpack_psip(size_t ni, const uint8_t* input, size_t no, T* output) {
-    std::array<T, 8> buffer;
-    std::fill_n(buffer.data(), buffer.size(), 0);
-    std::array<int, 8> bits;
-    std::fill_n(bits.data(), bits.size(), 0);
-    auto baseline = initialize_baseline<Scheme, T>();
-
-    // Rle-related equivalents; this needs to be duplicated to ensure that we
-    // can successfully recover lengths greater than T's max value.
-    std::array<size_t, 8> rle_buffer;
-    std::fill_n(rle_buffer.data(), rle_buffer.size(), 0);
-    auto rle_baseline = initialize_baseline<Scheme, size_t>();
-
-    // A boolean flag indicating whether we're still in the preamble.
-    // We use int for easier multiplications below. We start at 1
-    // to support the situation where the first entry is a preamble;
-    // if it isn't, then it'll get flipped to zero anyway.
-    int preamble = 1; 
-
-    // Remaining bits to process in the current integer. We set it to
-    // 1 because that's what is expected at the start of a new integer. 
-    int remaining = 1; 
-
-    // Where are we with respect to the buffers?
-    int at = 0; 
+    std::array<T, 8> baseline;
+    std::array<size_t, 8> rle_baseline;
+
+    // Number of preamble bits for the current code.
+    int bits = 0;
+
+    // Remaining payload bits to process for the current code;
+    // if zero, we're still in the preamble.
+    int remaining = 0;
+
+    // Payload accumulated from previous bytes. This is always 64 bits
+    // so that we can recover RLE lengths greater than T's max value.
+    uint64_t acc = 0;
+
+    // Whether the next code is the length of an RLE run.
+    bool rle = false;
+};
+
+/**
+ * @brief Expansions of bytes that only contain 1- and 2-bit codes under `Doubling<1>`.
+ *
+ * @tparam T Type of the unpacked integers.
+ */
+template<typename T>
+struct ShortCodeTable {
+private:
+    static constexpr std::array<std::array<T, 8>, 256> build_values() {
+        std::array<std::array<T, 8>, 256> output{};
+        for (int v = 0; v < 256; ++v) {
+            int count = 0;
+            for (int p = 7; p >= 0; --p) {
+                if (v & (1 << p)) {
+                    output[v][count] = 2;
+                    --p; // skipping the terminating zero of the preamble.
+                } else {
+                    output[v][count] = 1;
+                }
+                ++count;
+            }
+        }
+        return output;
+    }
 
-    size_t i = 0;
-    while (i < ni) {
-        auto val = *input;
-
-        if (preamble == 1 && val == 0b11111111) {
-            // Rle mode; running through and extracting the length.
-            preamble = 1;
-            remaining = 1;
-            bits[at] = 0;
-
-            do {
-                ++i;
-                ++input;
-                val = *input;
-
-                unpack_psip_step<Scheme>((val & 0b10000000) != 0, bits, rle_buffer, preamble, remaining, at);
-                unpack_psip_step<Scheme>((val & 0b01000000) != 0, bits, rle_buffer, preamble, remaining, at);
-                unpack_psip_step<Scheme>((val & 0b00100000) != 0, bits, rle_buffer, preamble, remaining, at);
-                unpack_psip_step<Scheme>((val & 0b00010000) != 0, bits, rle_buffer, preamble, remaining, at);
-                unpack_psip_step<Scheme>((val & 0b00001000) != 0, bits, rle_buffer, preamble, remaining, at);
-                unpack_psip_step<Scheme>((val & 0b00000100) != 0, bits, rle_buffer, preamble, remaining, at);
-                unpack_psip_step<Scheme>((val & 0b00000010) != 0, bits, rle_buffer, preamble, remaining, at);
-                unpack_psip_step<Scheme>((val & 0b00000001) != 0, bits, rle_buffer, preamble, remaining, at);
-
-            } while (at == 0 && i != ni - 1);
-
-            size_t len = rle_buffer[0] + rle_baseline[bits[0]];
-            size_t extra = len - 1; // extra ones to add, beyond the value already added.
-            std::fill(output, output + extra, *(output - 1)); // cloning
-            output += extra;
-            no -= extra;
-
-            // Moving any other results to the output buffer.
-            int bound = std::min(static_cast<size_t>(at), no);
-            for (int b = 1; b < bound; ++b, ++output) {
-                *output = rle_buffer[b] + baseline[bits[b]];
+    static constexpr std::array<uint8_t, 256> build_counts() {
+        std::array<uint8_t, 256> output{};
+        for (int v = 0; v < 256; ++v) {
+            int count = 8;
+            for (int p = 0; p < 8; ++p) {
+                count -= (v >> p) & 1;
             }
-            no -= bound - 1; // because we already processed the first.
+            output[v] = count;
+        }
+        return output;
+    }
 
-            // Preparing for the next byte.
-            std::fill_n(rle_buffer.data(), at, 0);
-            std::fill_n(bits.data(), at, 0);
-            if (at && at < buffer.size()) {
-                buffer[0] = rle_buffer[at];
-                rle_buffer[at] = 0;
-                std::swap(bits[0], bits[at]);
-            } 
-            at = 0;
+public:
+    /**
+     * Unpacked integers for each byte, padded to 8 entries.
+     * Only meaningful for bytes where `is_short_code_byte()` is true.
+     */
+    inline static const std::array<std::array<T, 8>, 256> values = build_values();
+
+    /**
+     * Number of unpacked integers for each byte.
+     */
+    inline static const std::array<uint8_t, 256> counts = build_counts();
+};
+
+template<class Scheme, typename T, class Step>
+void unpack_psip_internal(size_t ni, const uint8_t* input, size_t no, T* output, Step step) {
+    ByteDecoder<Scheme, T> decoder;
+
+    auto value = [&](T val) -> void {
+        if (no) {
+            *output = val;
+            ++output;
+            --no;
+        }
+    };
 
-            ++i;
-            ++input;
+    auto repeat = [&](size_t extra) -> void {
+        extra = std::min(extra, no);
+        std::fill_n(output, extra, *(output - 1)); // cloning
+        output += extra;
+        no -= extra;
+    };
 
-        } else {
-            // Manually unrolled. 
-            unpack_psip_step<Scheme>((val & 0b10000000) != 0, bits, buffer, preamble, remaining, at);
-            unpack_psip_step<Scheme>((val & 0b01000000) != 0, bits, buffer, preamble, remaining, at);
-            unpack_psip_step<Scheme>((val & 0b00100000) != 0, bits, buffer, preamble, remaining, at);
-            unpack_psip_step<Scheme>((val & 0b00010000) != 0, bits, buffer, preamble, remaining, at);
-            unpack_psip_step<Scheme>((val & 0b00001000) != 0, bits, buffer, preamble, remaining, at);
-            unpack_psip_step<Scheme>((val & 0b00000100) != 0, bits, buffer, preamble, remaining, at);
-            unpack_psip_step<Scheme>((val & 0b00000010) != 0, bits, buffer, preamble, remaining, at);
-            unpack_psip_step<Scheme>((val & 0b00000001) != 0, bits, buffer, preamble, remaining, at);
-
-            // Moving results to the output buffer.
-            int bound = std::min(static_cast<size_t>(at), no);
-            for (int i = 0; i < bound; ++i, ++output) {
-                *output = buffer[i] + baseline[bits[i]];
+    size_t i = 0;
+    while (i < ni && no) {
+        if constexpr(std::is_same<Scheme, Doubling<1> >::value) {
+            // Fast path for stretches of bytes containing only 1's and 2's.
+            // We need space for 8 integers per byte, as each expansion is
+            // written in full before advancing by the actual count.
+            if (decoder.fresh() && is_short_code_byte(input[i]) && no >= 8) {
+                size_t len = count_short_code_bytes(std::min(ni - i, no / 8), input + i);
+                SPACKER_DECODE_COUNT(short_code_bytes, len);
+                const auto& values = ShortCodeTable<T>::values;
+                const auto& counts = ShortCodeTable<T>::counts;
+                for (size_t j = 0; j < len; ++j) {
+                    auto v = input[i + j];
+                    std::copy_n(values[v].data(), 8, output);
+                    output += counts[v];
+                    no -= counts[v];
+                }
+                i += len; // guaranteed to be positive, as the current byte is short.
+                step(output);
+                continue;
             }
-            no -= bound;
-
-            // Resetting for the next byte.
-            std::fill_n(buffer.data(), at, 0);
-            std::fill_n(bits.data(), at, 0);
-            if (at && at < buffer.size()) {
-                std::swap(buffer[0], buffer[at]);
-                std::swap(bits[0], bits[at]);
-            } 
-            at = 0;
-
-            ++i;
-            ++input;
         }
+
+        decoder.consume(input[i], value, repeat);
+        ++i;
+        step(output);
     }
 
     return;
 }
 
+template<class Scheme = Doubling<>, typename T>
+void unpack_psip(size_t ni, const uint8_t* input, size_t no, T* output) {
+    unpack_psip_internal<Scheme>(ni, input, no, output, [](T*) -> void {});
+}
+
 }
 
 #endif
@@ -0,0 +1,46 @@
+#ifndef SPACKER_UNPACK_ADAPTIVE_HPP
+#define SPACKER_UNPACK_ADAPTIVE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+
+#include "SchemeId.hpp"
+#include "unpack_psip.hpp"
+#include "unpack_psip_parallel.hpp"
+
+/**
+ * @file unpack_psip_adaptive.hpp
+ *
+ * @brief Unpack blocks that were packed with different schemes.
+ */
+
+namespace spacker {
+
+/**
+ * @tparam T Type of the unpacked integers.
+ *
+ * @param ni Number of bytes in the packed input.
+ * @param input Pointer to a block-structured stream created by `pack_psip_adaptive()`.
+ * @param no Number of integers to unpack.
+ * @param output Pointer to an array of length `no`, to store the unpacked integers.
+ * @param nthreads Number of threads to use.
+ *
+ * Each block is unpacked with the `unpack_psip()` instance for the scheme in its tag.
+ * Blocks are scheduled as described in `unpack_blocks()`.
+ */
+template<typename T>
+void unpack_psip_adaptive(size_t ni, const uint8_t* input, size_t no, T* output, int nthreads = 1) {
+    unpack_blocks(ni, input, no, nthreads, [&](const uint8_t* block, size_t nbytes, size_t len, size_t start) -> void {
+        if (nbytes == 0) {
+            throw std::runtime_error("block is missing its scheme tag");
+        }
+        dispatch_scheme(static_cast<SchemeId>(block[0]), [&](auto scheme) -> void {
+            unpack_psip<decltype(scheme)>(nbytes - 1, block + 1, len, output + start);
+        });
+    });
+}
+
+}
+
+#endif
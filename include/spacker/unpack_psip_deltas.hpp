@@ -0,0 +1,53 @@
+#ifndef SPACKER_UNPACK_DELTAS_HPP
+#define SPACKER_UNPACK_DELTAS_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+#include "Doubling.hpp"
+#include "unpack_psip.hpp"
+#include "simd.hpp"
+
+/**
+ * @file unpack_psip_deltas.hpp
+ *
+ * @brief Unpack integers that were packed as their differences.
+ */
+
+namespace spacker {
+
+/**
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam T Type of the unpacked integers.
+ *
+ * @param ni Number of bytes in the packed input.
+ * @param input Pointer to the packed input, typically created by `pack_psip_deltas()`.
+ * @param no Number of integers to unpack.
+ * @param output Pointer to an array of length `no`, to store the unpacked integers.
+ *
+ * The differences are decoded directly into `output` and converted to prefix sums in small chunks while they are still in cache,
+ * so no temporary array is required.
+ */
+template<class Scheme = Doubling<>, typename T>
+void unpack_psip_deltas(size_t ni, const uint8_t* input, size_t no, T* output) {
+    constexpr size_t chunk = 1024;
+    T* summed = output;
+    T* decoded = output;
+    T carry = static_cast<T>(-1); // origin of -1, see pack_psip_deltas().
+
+    // The last decoded difference is left as-is, as it may be cloned by a subsequent RLE run.
+    unpack_psip_internal<Scheme>(ni, input, no, output, [&](T* current) -> void {
+        decoded = current;
+        size_t available = current - summed;
+        if (available > chunk) {
+            carry = prefix_sum(available - 1, summed, carry);
+            summed = current - 1;
+        }
+    });
+
+    prefix_sum(static_cast<size_t>(decoded - summed), summed, carry);
+}
+
+}
+
+#endif
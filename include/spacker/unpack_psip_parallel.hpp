@@ -0,0 +1,80 @@
+#ifndef SPACKER_UNPACK_PARALLEL_HPP
+#define SPACKER_UNPACK_PARALLEL_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+
+#include "Doubling.hpp"
+#include "unpack_psip.hpp"
+#include "BlockTable.hpp"
+#include "parallelize.hpp"
+
+/**
+ * @file unpack_psip_parallel.hpp
+ *
+ * @brief Unpack independent blocks in parallel.
+ */
+
+namespace spacker {
+
+/**
+ * @tparam Function Function to unpack a single block.
+ *
+ * @param ni Number of bytes in the packed input.
+ * @param input Pointer to a block-structured stream.
+ * @param no Number of integers to unpack.
+ * @param nthreads Number of threads to use.
+ * @param fun Function to be called with a pointer to the bytes of a block, the number of bytes in the block,
+ * the number of integers to unpack from the block, and the position of the block's first integer in the output.
+ *
+ * Threads pick up blocks one at a time, starting from the largest, so that threads finishing cheap blocks (e.g., long RLE runs) can take over the remaining work.
+ * Blocks that start at or after `no` are skipped, and the last block is truncated to `no`.
+ */
+template<class Function>
+void unpack_blocks(size_t ni, const uint8_t* input, size_t no, int nthreads, Function fun) {
+    auto table = read_block_header(ni, input);
+    size_t nblocks = table.size();
+
+    // Scheduling the largest blocks first.
+    std::vector<size_t> order(nblocks);
+    std::iota(order.begin(), order.end(), static_cast<size_t>(0));
+    std::stable_sort(order.begin(), order.end(), [&](size_t left, size_t right) -> bool {
+        return table.offsets[left + 1] - table.offsets[left] > table.offsets[right + 1] - table.offsets[right];
+    });
+
+    parallelize(nblocks, nthreads, [&](size_t t) -> void {
+        auto b = order[t];
+        auto start = table.starts[b];
+        if (start >= no) {
+            return;
+        }
+        auto len = std::min(table.starts[b + 1], no) - start;
+        fun(input + table.offsets[b], table.offsets[b + 1] - table.offsets[b], len, start);
+    });
+}
+
+/**
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam T Type of the unpacked integers.
+ *
+ * @param ni Number of bytes in the packed input.
+ * @param input Pointer to a block-structured stream, typically created by `pack_psip_blocked()`.
+ * @param no Number of integers to unpack.
+ * @param output Pointer to an array of length `no`, to store the unpacked integers.
+ * @param nthreads Number of threads to use.
+ *
+ * Each block is unpacked directly into its own range of `output`, as determined from the header.
+ * Blocks are scheduled as described in `unpack_blocks()`.
+ */
+template<class Scheme = Doubling<>, typename T>
+void unpack_psip_parallel(size_t ni, const uint8_t* input, size_t no, T* output, int nthreads = 1) {
+    unpack_blocks(ni, input, no, nthreads, [&](const uint8_t* block, size_t nbytes, size_t len, size_t start) -> void {
+        unpack_psip<Scheme>(nbytes, block, len, output + start);
+    });
+}
+}
+
+#endif
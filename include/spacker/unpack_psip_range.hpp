@@ -0,0 +1,76 @@
+#ifndef SPACKER_UNPACK_RANGE_HPP
+#define SPACKER_UNPACK_RANGE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+#include "Doubling.hpp"
+#include "SeekIndex.hpp"
+#include "unpack_psip_wide.hpp"
+
+/**
+ * @file unpack_psip_range.hpp
+ *
+ * @brief Unpack a slice of a packed stream.
+ */
+
+namespace spacker {
+
+/**
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam T Type of the unpacked integers.
+ *
+ * @param ni Number of bytes in the packed input.
+ * @param input Pointer to the packed input, created by `pack_psip()`.
+ * @param index Index created by `pack_psip()` for `input`.
+ * @param start Position of the first integer to unpack.
+ * @param end Position past the last integer to unpack.
+ * This should be no greater than the total number of packed integers.
+ * @param output Pointer to an array of length `end - start`, to store the unpacked integers.
+ *
+ * Decoding starts from the last point in `index` before `start`,
+ * so the cost is proportional to `SeekIndex::interval` plus the length of the slice.
+ */
+template<class Scheme = Doubling<>, typename T>
+void unpack_psip_range(size_t ni, const uint8_t* input, const SeekIndex& index, size_t start, size_t end, T* output) {
+    if (start >= end) {
+        return;
+    }
+
+    const auto& points = index.points;
+    auto it = std::upper_bound(points.begin(), points.end(), start, [](size_t s, const SeekPoint& p) -> bool { return s < p.count; });
+    size_t position = 0, current = 0;
+    if (it != points.begin()) {
+        --it;
+        position = it->byte * 8 + it->bit;
+        current = it->count;
+    }
+
+    WideDecoder<Scheme, T> decoder(ni, input, position);
+    T last = 0;
+
+    auto value = [&](T val) -> void {
+        if (current >= start) {
+            output[current - start] = val;
+        }
+        last = val;
+        ++current;
+    };
+
+    auto repeat = [&](size_t extra) -> void {
+        size_t first = std::max(current, start);
+        size_t stop = std::min(current + extra, end);
+        if (first < stop) {
+            std::fill(output + (first - start), output + (stop - start), last);
+        }
+        current += extra;
+    };
+
+    while (current < end && decoder.next(value, repeat)) {}
+    return;
+}
+
+}
+
+#endif
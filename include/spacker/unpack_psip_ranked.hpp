@@ -0,0 +1,71 @@
+#ifndef SPACKER_UNPACK_RANKED_HPP
+#define SPACKER_UNPACK_RANKED_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+
+#include "Doubling.hpp"
+#include "unpack_psip.hpp"
+
+/**
+ * @file unpack_psip_ranked.hpp
+ *
+ * @brief Unpack integers that were packed as their frequency ranks.
+ */
+
+namespace spacker {
+
+/**
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam T Type of the unpacked integers.
+ *
+ * @param ni Number of bytes in the packed input.
+ * @param input Pointer to the packed input, created by `pack_psip_ranked()`.
+ * @param no Number of integers to unpack.
+ * @param output Pointer to an array of length `no`, to store the unpacked integers.
+ *
+ * The dictionary is read from the start of the stream, and each subsequent rank is mapped back to its value through a lookup table.
+ * A `std::runtime_error` is thrown if a rank is not present in the dictionary.
+ */
+template<class Scheme = Doubling<>, typename T>
+void unpack_psip_ranked(size_t ni, const uint8_t* input, size_t no, T* output) {
+    ByteDecoder<Scheme, T> decoder;
+    std::vector<T> dictionary;
+    size_t expected = 0;
+    bool has_size = false;
+
+    auto value = [&](T val) -> void {
+        if (!has_size) {
+            expected = val;
+            dictionary.reserve(expected);
+            has_size = true;
+        } else if (dictionary.size() < expected) {
+            dictionary.push_back(val);
+        } else if (no) {
+            if (static_cast<size_t>(val) > dictionary.size()) {
+                throw std::runtime_error("rank is not present in the dictionary");
+            }
+            *output = dictionary[val - 1];
+            ++output;
+            --no;
+        }
+    };
+
+    auto repeat = [&](size_t extra) -> void {
+        extra = std::min(extra, no);
+        std::fill_n(output, extra, *(output - 1)); // cloning
+        output += extra;
+        no -= extra;
+    };
+
+    for (size_t i = 0; i < ni && no; ++i) {
+        decoder.consume(input[i], value, repeat);
+    }
+}
+
+}
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef SPACKER_UNPACK_RUNS_HPP
+#define SPACKER_UNPACK_RUNS_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+#include "Doubling.hpp"
+#include "unpack_psip.hpp"
+
+/**
+ * @file unpack_psip_runs.hpp
+ *
+ * @brief Unpack integers as runs of identical values.
+ */
+
+namespace spacker {
+
+template<class Scheme, typename T, class Run>
+void unpack_psip_runs_internal(size_t ni, const uint8_t* input, size_t no, Run run) {
+    ByteDecoder<Scheme, T> decoder;
+    T current = 0;
+    size_t length = 0;
+
+    auto value = [&](T val) -> void {
+        if (!no) {
+            return;
+        }
+        if (length && val == current) {
+            ++length;
+        } else {
+            if (length) {
+                run(current, length);
+            }
+            current = val;
+            length = 1;
+        }
+        --no;
+    };
+
+    auto repeat = [&](size_t extra) -> void {
+        if (length) { // RLE markers should always follow a literal, but we check just in case.
+            extra = std::min(extra, no);
+            length += extra;
+            no -= extra;
+        }
+    };
+
+    for (size_t i = 0; i < ni && no; ++i) {
+        decoder.consume(input[i], value, repeat);
+    }
+
+    if (length) {
+        run(current, length);
+    }
+}
+
+/**
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam T Type of the unpacked integers.
+ *
+ * @param ni Number of bytes in the packed input.
+ * @param input Pointer to the packed input, created by `pack_psip()`.
+ * @param no Number of integers to unpack.
+ *
+ * @return Pairs of values and the lengths of their runs, in the order in which they occur in the unpacked stream.
+ * The lengths sum to `no`, or less if `input` contains fewer integers.
+ *
+ * RLE runs are reported directly from their encoded lengths, and adjacent literals with the same value are merged into a single run.
+ * This means that no two consecutive runs have the same value, regardless of whether RLE was used for packing.
+ * Memory usage is proportional to the number of runs rather than `no`.
+ */
+template<class Scheme = Doubling<>, typename T = uint32_t>
+std::vector<std::pair<T, size_t> > unpack_psip_runs(size_t ni, const uint8_t* input, size_t no) {
+    std::vector<std::pair<T, size_t> > output;
+    unpack_psip_runs_internal<Scheme, T>(ni, input, no, [&](T val, size_t length) -> void {
+        output.emplace_back(val, length);
+    });
+    return output;
+}
+
+}
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef SPACKER_UNPACK_TRANSFORMED_HPP
+#define SPACKER_UNPACK_TRANSFORMED_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+#include "Doubling.hpp"
+#include "Zigzag.hpp"
+#include "Offset.hpp"
+#include "unpack_psip.hpp"
+
+/**
+ * @file unpack_psip_transformed.hpp
+ *
+ * @brief Unpack integers that were packed as transformed codes.
+ */
+
+namespace spacker {
+
+/**
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam T Type of the unpacked integers.
+ * @tparam Transform Class with a `reverse()` method that maps each `uint64_t` code back to an integer, e.g., `Zigzag`, `Offset`.
+ *
+ * @param ni Number of bytes in the packed input.
+ * @param input Pointer to the packed input, typically created by `pack_psip_transformed()`.
+ * @param no Number of integers to unpack.
+ * @param output Pointer to an array of length `no`, to store the unpacked integers.
+ * @param transform Instance of the transform, identical to that used for packing.
+ *
+ * Each code is reversed as it is decoded, so no temporary array is required.
+ */
+template<class Scheme = Doubling<>, typename T, class Transform>
+void unpack_psip_transformed(size_t ni, const uint8_t* input, size_t no, T* output, const Transform& transform) {
+    ByteDecoder<Scheme, uint64_t> decoder;
+
+    auto value = [&](uint64_t code) -> void {
+        if (no) {
+            *output = transform.reverse(code);
+            ++output;
+            --no;
+        }
+    };
+
+    auto repeat = [&](size_t extra) -> void {
+        extra = std::min(extra, no);
+        std::fill_n(output, extra, *(output - 1)); // cloning
+        output += extra;
+        no -= extra;
+    };
+
+    for (size_t i = 0; i < ni && no; ++i) {
+        decoder.consume(input[i], value, repeat);
+    }
+}
+
+/**
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam T Signed integer type.
+ *
+ * @param ni Number of bytes in the packed input.
+ * @param input Pointer to the packed input, created by `pack_psip_zigzag()`.
+ * @param no Number of integers to unpack.
+ * @param output Pointer to an array of length `no`, to store the unpacked integers.
+ */
+template<class Scheme = Doubling<>, typename T>
+void unpack_psip_zigzag(size_t ni, const uint8_t* input, size_t no, T* output) {
+    unpack_psip_transformed<Scheme>(ni, input, no, output, Zigzag<T>());
+}
+
+/**
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam T Integer type.
+ *
+ * @param ni Number of bytes in the packed input.
+ * @param input Pointer to the packed input, created by `pack_psip_offset()`.
+ * @param no Number of integers to unpack.
+ * @param output Pointer to an array of length `no`, to store the unpacked integers.
+ * @param offset Lower bound that was used in `pack_psip_offset()`.
+ */
+template<class Scheme = Doubling<>, typename T>
+void unpack_psip_offset(size_t ni, const uint8_t* input, size_t no, T* output, T offset) {
+    unpack_psip_transformed<Scheme>(ni, input, no, output, Offset<T>(offset));
+}
+
+}
+
+#endif
@@ -0,0 +1,151 @@
+#ifndef SPACKER_UNPACK_WIDE_HPP
+#define SPACKER_UNPACK_WIDE_HPP
+
+#include <cstdint>
+#include <array>
+#include <algorithm>
+
+#include "utils.hpp"
+#include "Doubling.hpp"
+#include "BitReader.hpp"
+#include "TransitionTable.hpp"
+#include "unpack_psip.hpp"
+
+/**
+ * @file unpack_psip_wide.hpp
+ *
+ * @brief Unpack codes through a 64-bit window.
+ */
+
+namespace spacker {
+
+/**
+ * @brief Code-at-a-time decoder for the positive small integer packer.
+ *
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam T Type of the unpacked integers.
+ *
+ * This decodes one code at a time from a `BitReader`,
+ * using the number of leading ones to determine the preamble length and extracting the payload with a single shift.
+ * It is most effective for large integers, whose codes span multiple bytes.
+ * It can also start decoding from any bit, provided that this is the start of a code.
+ */
+template<class Scheme, typename T>
+class WideDecoder {
+public:
+    /**
+     * @param n Number of bytes in the input.
+     * @param input Pointer to the input bytes.
+     * @param start Position of the first bit to decode.
+     */
+    WideDecoder(size_t n, const uint8_t* input, size_t start = 0) :
+        reader(n, input, start),
+        baseline(initialize_baseline<Scheme, T>()),
+        rle_baseline(initialize_baseline<Scheme, size_t>())
+    {}
+
+    /**
+     * @param value Function to be called with the decoded integer.
+     * @param repeat Function to be called with the number of additional copies of the last decoded integer, if the next code is an RLE run.
+     * @return Whether a code was decoded, i.e., `false` if the input does not contain any more complete codes.
+     */
+    template<class Value, class Repeat>
+    bool next(Value& value, Repeat& repeat) {
+        reader.refill();
+        int ones = count_leading_ones(reader.window());
+
+        // A valid preamble cannot be longer than 7 bits, so this must be
+        // (padding to the end of the byte) + (the RLE marker).
+        bool rle = ones >= 8;
+        if (rle) {
+            int padding = (8 - reader.position() % 8) % 8;
+            if (padding + 8 > reader.available()) {
+                return false;
+            }
+            reader.skip(padding + 8);
+            reader.refill();
+            ones = count_leading_ones(reader.window());
+        }
+
+        if (ones >= reader.available() || ones > 7) {
+            return false;
+        }
+        reader.skip(ones + 1);
+
+        int remaining = Table::payloads[ones];
+        uint64_t payload;
+        if (remaining <= reader.available()) {
+            payload = reader.read(remaining);
+        } else {
+            // Only possible for payloads that are wider than the window.
+            payload = 0;
+            do {
+                reader.refill();
+                int take = std::min(remaining, 56);
+                if (take > reader.available()) {
+                    return false;
+                }
+                payload = (payload << take) | reader.read(take); // any high bits that get shifted out are zero anyway.
+                remaining -= take;
+            } while (remaining);
+        }
+
+        if (rle) {
+            size_t len = payload + rle_baseline[ones];
+            repeat(len - 1); // extra copies to add, beyond the value already added.
+        } else {
+            value(static_cast<T>(payload) + baseline[ones]);
+        }
+
+        return true;
+    }
+
+    /**
+     * @return Position of the start of the next code, in bits from the start of the input.
+     */
+    size_t position() const {
+        return reader.position();
+    }
+
+private:
+    typedef TransitionTable<Scheme> Table;
+    BitReader reader;
+    std::array<T, 8> baseline;
+    std::array<size_t, 8> rle_baseline;
+};
+
+/**
+ * @tparam Scheme Class specifying the width of each code, e.g., `Doubling`, `Multiplier`.
+ * @tparam T Type of the unpacked integers.
+ *
+ * @param ni Number of bytes in the packed input.
+ * @param input Pointer to the packed input, typically created by `pack_psip()`.
+ * @param no Number of integers to unpack.
+ * @param output Pointer to an array of length `no`, to store the unpacked integers.
+ *
+ * This is equivalent to `unpack_psip()` but uses a `WideDecoder`, which is faster for large integers.
+ */
+template<class Scheme = Doubling<>, typename T>
+void unpack_psip_wide(size_t ni, const uint8_t* input, size_t no, T* output) {
+    WideDecoder<Scheme, T> decoder(ni, input);
+
+    auto value = [&](T val) -> void {
+        *output = val;
+        ++output;
+        --no;
+    };
+
+    auto repeat = [&](size_t extra) -> void {
+        extra = std::min(extra, no);
+        std::fill_n(output, extra, *(output - 1)); // cloning
+        output += extra;
+        no -= extra;
+    };
+
+    while (no && decoder.next(value, repeat)) {}
+    return;
+}
+
+}
+
+#endif
@@ -0,0 +1,58 @@
+#include "spacker/dispatch.hpp"
+#include "spacker/pack_psip.hpp"
+#include "spacker/unpack_psip.hpp"
+
+#include <stdexcept>
+
+namespace spacker {
+
+SchemeId parse_scheme_id(const std::string& name) {
+    if (name == "doubling1") {
+        return SchemeId::DOUBLING_1;
+    } else if (name == "doubling2") {
+        return SchemeId::DOUBLING_2;
+    } else if (name == "doubling4") {
+        return SchemeId::DOUBLING_4;
+    } else if (name == "multiplier4") {
+        return SchemeId::MULTIPLIER_4;
+    } else if (name == "multiplier8") {
+        return SchemeId::MULTIPLIER_8;
+    }
+    throw std::runtime_error("unknown scheme name '" + name + "'");
+}
+
+template<typename T>
+std::vector<uint8_t> pack_psip_dispatch_internal(SchemeId id, bool rle, size_t n, const T* input) {
+    return dispatch_scheme(id, [&](auto scheme) -> std::vector<uint8_t> {
+        typedef decltype(scheme) Scheme;
+        if (rle) {
+            return pack_psip<true, Scheme>(n, input);
+        } else {
+            return pack_psip<false, Scheme>(n, input);
+        }
+    });
+}
+
+template<typename T>
+void unpack_psip_dispatch_internal(SchemeId id, size_t ni, const uint8_t* input, size_t no, T* output) {
+    dispatch_scheme(id, [&](auto scheme) -> void {
+        unpack_psip<decltype(scheme)>(ni, input, no, output);
+    });
+}
+
+#define SPACKER_DISPATCH_INSTANTIATE(T) \
+std::vector<uint8_t> pack_psip_dispatch(SchemeId id, bool rle, size_t n, const T* input) { \
+    return pack_psip_dispatch_internal(id, rle, n, input); \
+} \
+void unpack_psip_dispatch(SchemeId id, size_t ni, const uint8_t* input, size_t no, T* output) { \
+    unpack_psip_dispatch_internal(id, ni, input, no, output); \
+}
+
+SPACKER_DISPATCH_INSTANTIATE(uint8_t)
+SPACKER_DISPATCH_INSTANTIATE(uint16_t)
+SPACKER_DISPATCH_INSTANTIATE(uint32_t)
+SPACKER_DISPATCH_INSTANTIATE(uint64_t)
+
+#undef SPACKER_DISPATCH_INSTANTIATE
+
+}
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include "spacker/pack_psip_adaptive.hpp"
+#include "spacker/unpack_psip_adaptive.hpp"
+#include "spacker/pack_psip.hpp"
+#include "spacker/unpack_psip.hpp"
+#include "spacker/BlockTable.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <random>
+
+TEST(SchemeIdTest, Dispatch) {
+    std::vector<uint32_t> x{ 1, 2, 3, 100, 100, 100, 100, 5000 };
+    for (auto id : spacker::all_scheme_ids) {
+        auto packed = spacker::dispatch_scheme(id, [&](auto scheme) -> std::vector<uint8_t> {
+            return spacker::pack_psip<true, decltype(scheme)>(x.size(), x.data());
+        });
+        std::vector<uint32_t> output(x.size());
+        spacker::dispatch_scheme(id, [&](auto scheme) -> void {
+            spacker::unpack_psip<decltype(scheme)>(packed.size(), packed.data(), output.size(), output.data());
+        });
+        EXPECT_EQ(output, x);
+    }
+
+    EXPECT_ANY_THROW(spacker::dispatch_scheme(static_cast<spacker::SchemeId>(100), [](auto) -> int { return 0; }));
+}
+
+TEST(SchemeIdTest, MaxPackable) {
+    // The first class that is wider than T can hold all remaining integers.
+    EXPECT_EQ((spacker::max_packable<uint8_t, spacker::Doubling<> >()), 255);
+    EXPECT_EQ((spacker::max_packable<uint32_t, spacker::Multiplier<8> >()), std::numeric_limits<uint32_t>::max());
+
+    // The first class that is wider than T has a payload of 15 bits, after the 4680 integers in the previous classes.
+    EXPECT_EQ((spacker::max_packable<uint16_t, spacker::Multiplier<> >()), 4680 + 32768);
+
+    // All classes fit in T.
+    EXPECT_EQ((spacker::max_packable<uint64_t, spacker::Multiplier<> >()), (spacker::max<uint64_t, spacker::Multiplier<>, 7>()));
+
+    // Checking that the limits are consistent with the packer.
+    std::vector<uint16_t> x{ 1, 4681, 37448, 2 };
+    auto packed = spacker::pack_psip<true, spacker::Multiplier<> >(x.size(), x.data());
+    std::vector<uint16_t> output(x.size());
+    spacker::unpack_psip<spacker::Multiplier<> >(packed.size(), packed.data(), output.size(), output.data());
+    EXPECT_EQ(output, x);
+}
+
+template<typename T>
+size_t exact_size(spacker::SchemeId id, const std::vector<T>& x) {
+    return spacker::dispatch_scheme(id, [&](auto scheme) -> size_t {
+        return spacker::packed_size<true, decltype(scheme)>(x.size(), x.data());
+    });
+}
+
+TEST(AdaptiveTest, ChooseScheme) {
+    // All ones.
+    std::vector<uint32_t> ones(1000, 1);
+    ones[500] = 2; // avoid a single run.
+    EXPECT_EQ(spacker::choose_scheme(ones.size(), ones.data()), spacker::SchemeId::DOUBLING_1);
+
+    // Medium-sized counts.
+    std::mt19937_64 rng(42);
+    std::vector<uint32_t> counts(1000);
+    for (auto& c : counts) {
+        c = rng() % 200 + 50;
+    }
+    auto chosen = spacker::choose_scheme(counts.size(), counts.data());
+    EXPECT_NE(chosen, spacker::SchemeId::DOUBLING_1);
+
+    // The choice should be the best or close to it.
+    for (auto id : spacker::all_scheme_ids) {
+        EXPECT_TRUE(exact_size(chosen, counts) <= exact_size(id, counts) * 1.02);
+    }
+
+    // Schemes that can't hold the value are not chosen.
+    std::vector<uint16_t> large{ 50000, 1, 1 };
+    auto chosen16 = spacker::choose_scheme(large.size(), large.data());
+    EXPECT_NE(chosen16, spacker::SchemeId::MULTIPLIER_4);
+}
+
+TEST(AdaptiveTest, RoundTrip) {
+    // Mixture of all-ones blocks and high-count blocks.
+    std::mt19937_64 rng(69);
+    std::vector<uint32_t> x;
+    for (int b = 0; b < 6; ++b) {
+        for (int i = 0; i < 1000; ++i) {
+            if (b % 2 == 0) {
+                x.push_back(rng() % 20 == 0 ? 2 : 1);
+            } else {
+                x.push_back(rng() % 1000 + 100);
+            }
+        }
+    }
+
+    auto packed = spacker::pack_psip_adaptive(x.size(), x.data(), 1000);
+    auto table = spacker::read_block_header(packed.size(), packed.data());
+    EXPECT_EQ(table.size(), 6);
+    EXPECT_EQ(static_cast<spacker::SchemeId>(packed[table.offsets[0]]), spacker::SchemeId::DOUBLING_1);
+    EXPECT_NE(static_cast<spacker::SchemeId>(packed[table.offsets[1]]), spacker::SchemeId::DOUBLING_1);
+
+    // Better than any single scheme.
+    auto single = spacker::pack_psip_blocked(x.size(), x.data(), 1000);
+    EXPECT_TRUE(packed.size() < single.size());
+
+    for (int nthreads = 1; nthreads <= 3; ++nthreads) {
+        std::vector<uint32_t> output(x.size());
+        spacker::unpack_psip_adaptive(packed.size(), packed.data(), output.size(), output.data(), nthreads);
+        EXPECT_EQ(output, x);
+    }
+
+    auto packed_nonrle = spacker::pack_psip_adaptive<false>(x.size(), x.data(), 1000, 2);
+    std::vector<uint32_t> output(x.size());
+    spacker::unpack_psip_adaptive(packed_nonrle.size(), packed_nonrle.data(), output.size(), output.data());
+    EXPECT_EQ(output, x);
+
+    std::vector<uint32_t> empty;
+    auto packed_empty = spacker::pack_psip_adaptive(empty.size(), empty.data());
+    spacker::unpack_psip_adaptive(packed_empty.size(), packed_empty.data(), 0, empty.data());
+}
+
+TEST(AdaptiveTest, WiderThanType) {
+    // Mostly ones, with a single value in the first class of Doubling<1> that is wider than 16 bits.
+    std::vector<uint16_t> x(60000, 1);
+    for (size_t i = 0; i < x.size(); i += 7) {
+        x[i] = 2;
+    }
+    x[30000] = 3000;
+
+    EXPECT_EQ(spacker::choose_scheme(x.size(), x.data()), spacker::SchemeId::DOUBLING_1);
+
+    auto packed = spacker::pack_psip_adaptive(x.size(), x.data());
+    auto single = spacker::pack_psip(x.size(), x.data());
+    EXPECT_TRUE(packed.size() < single.size() + 64);
+
+    std::vector<uint16_t> output(x.size());
+    spacker::unpack_psip_adaptive(packed.size(), packed.data(), output.size(), output.data());
+    EXPECT_EQ(output, x);
+}
+
+TEST(AdaptiveTest, RandomTypes) {
+    std::mt19937_64 rng(123);
+    std::vector<uint64_t> x64;
+    std::vector<uint8_t> x8;
+    for (int i = 0; i < 5000; ++i) {
+        x64.push_back((rng() >> (rng() % 60 + 4)) + 1);
+        x8.push_back(rng() % 100 + 1);
+    }
+
+    auto packed64 = spacker::pack_psip_adaptive(x64.size(), x64.data(), 512);
+    std::vector<uint64_t> output64(x64.size());
+    spacker::unpack_psip_adaptive(packed64.size(), packed64.data(), output64.size(), output64.data());
+    EXPECT_EQ(output64, x64);
+
+    auto packed8 = spacker::pack_psip_adaptive(x8.size(), x8.data(), 512);
+    std::vector<uint8_t> output8(x8.size());
+    spacker::unpack_psip_adaptive(packed8.size(), packed8.data(), output8.size(), output8.data());
+    EXPECT_EQ(output8, x8);
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include "spacker/pack_psip.hpp"
+#include "spacker/unpack_psip.hpp"
+#include "spacker/psip_aggregate.hpp"
+#include "spacker/Multiplier.hpp"
+
+#include <cstdint>
+#include <random>
+#include <map>
+
+template<bool rle, class Scheme, typename T>
+void check_aggregates(const std::vector<T>& input) {
+    auto packed = spacker::pack_psip<rle, Scheme>(input.size(), input.data());
+
+    for (size_t n : { input.size(), input.size() / 3 }) {
+        uint64_t sum = 0, largest = 0;
+        size_t ones = 0;
+        std::map<uint64_t, size_t> counts;
+        for (size_t i = 0; i < n; ++i) {
+            sum += input[i];
+            largest = std::max<uint64_t>(largest, input[i]);
+            ones += (input[i] == 1);
+            ++counts[input[i]];
+        }
+
+        EXPECT_EQ(spacker::psip_sum<Scheme>(packed.size(), packed.data(), n), sum);
+        EXPECT_EQ(spacker::psip_max<Scheme>(packed.size(), packed.data(), n), largest);
+        EXPECT_EQ(spacker::psip_count_equal<Scheme>(packed.size(), packed.data(), n, 1), ones);
+
+        std::vector<std::pair<uint64_t, size_t> > expected(counts.begin(), counts.end());
+        EXPECT_EQ(spacker::psip_histogram<Scheme>(packed.size(), packed.data(), n), expected);
+    }
+}
+
+TEST(AggregateTest, Basic) {
+    std::vector<uint32_t> x{ 1, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 7, 100000, 2, 2 };
+    auto packed = spacker::pack_psip(x.size(), x.data());
+    EXPECT_EQ(spacker::psip_sum(packed.size(), packed.data(), x.size()), 100031u);
+    EXPECT_EQ(spacker::psip_max(packed.size(), packed.data(), x.size()), 100000u);
+    EXPECT_EQ(spacker::psip_count_equal(packed.size(), packed.data(), x.size(), 2), 3u);
+
+    check_aggregates<true, spacker::Doubling<> >(x);
+    check_aggregates<false, spacker::Doubling<> >(x);
+
+    std::vector<uint32_t> empty;
+    check_aggregates<true, spacker::Doubling<> >(empty);
+}
+
+TEST(AggregateTest, ShortCodes) {
+    // Mostly 1's and 2's to exercise the popcount path, with runs that follow short-code stretches.
+    std::mt19937_64 rng(7);
+    for (int iter = 0; iter < 10; ++iter) {
+        std::vector<uint32_t> x;
+        while (x.size() < 20000) {
+            auto choice = rng() % 200;
+            if (choice == 0) {
+                x.insert(x.end(), rng() % 100 + 1, rng() % 2 + 1);
+            } else if (choice == 1) {
+                x.push_back(rng() % 100000 + 1);
+            } else {
+                x.push_back(rng() % 2 + 1);
+            }
+        }
+
+        check_aggregates<true, spacker::Doubling<> >(x);
+        check_aggregates<false, spacker::Doubling<> >(x);
+        check_aggregates<true, spacker::Doubling<2> >(x);
+        check_aggregates<true, spacker::Multiplier<4> >(x);
+    }
+}
+
+TEST(AggregateTest, LargeValues) {
+    std::mt19937_64 rng(8);
+    std::vector<uint64_t> x(5000);
+    for (auto& v : x) {
+        v = (rng() >> (rng() % 64)) + 1;
+        if (v == 0) {
+            v = 1;
+        }
+    }
+    check_aggregates<true, spacker::Doubling<> >(x);
+    check_aggregates<false, spacker::Doubling<2> >(x);
+}
+
+TEST(AggregateTest, SetBits) {
+    std::mt19937_64 rng(9);
+    for (size_t len = 0; len < 50; ++len) {
+        std::vector<uint8_t> x(len);
+        size_t expected = 0;
+        for (auto& v : x) {
+            v = rng();
+            for (int b = 0; b < 8; ++b) {
+                expected += (v >> b) & 1;
+            }
+        }
+        EXPECT_EQ(spacker::count_set_bits_scalar(len, x.data()), expected);
+        EXPECT_EQ(spacker::count_set_bits(len, x.data()), expected);
+    }
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include "spacker/pack_psip.hpp"
+
+#include <vector>
+#include <deque>
+#include <cstdint>
+#include <random>
+
+template<class Output>
+std::vector<std::pair<uint64_t, int> > write_random(Output& output, spacker::BitWriter& writer, std::mt19937_64& rng) {
+    std::vector<std::pair<uint64_t, int> > written;
+    for (int i = 0; i < 1000; ++i) {
+        int n = rng() % 65;
+        uint64_t bits = (n == 0 ? 0 : rng() >> (64 - n));
+        writer.write(bits, n, output);
+        written.emplace_back(bits, n);
+    }
+    return written;
+}
+
+void check_written(const std::vector<uint8_t>& output, const std::vector<std::pair<uint64_t, int> >& written) {
+    size_t total = 0;
+    for (const auto& w : written) {
+        total += w.second;
+    }
+    EXPECT_EQ(output.size(), (total + 7) / 8);
+
+    size_t pos = 0;
+    for (const auto& w : written) {
+        uint64_t observed = 0;
+        for (int b = 0; b < w.second; ++b, ++pos) {
+            observed <<= 1;
+            observed |= (output[pos / 8] >> (7 - pos % 8)) & 1;
+        }
+        EXPECT_EQ(observed, w.first);
+    }
+
+    // Checking that the padding is all zeros.
+    for (; pos < output.size() * 8; ++pos) {
+        EXPECT_EQ((output[pos / 8] >> (7 - pos % 8)) & 1, 0);
+    }
+}
+
+TEST(BitWriterTest, Vector) {
+    std::mt19937_64 rng(100);
+    std::vector<uint8_t> output;
+    spacker::BitWriter writer;
+    auto written = write_random(output, writer, rng);
+    writer.finish(output);
+    EXPECT_EQ(writer.pending(), 0);
+    check_written(output, written);
+}
+
+TEST(BitWriterTest, OtherContainers) {
+    std::mt19937_64 rng(200);
+    std::deque<uint8_t> output;
+    spacker::BitWriter writer;
+    auto written = write_random(output, writer, rng);
+    writer.finish(output);
+    check_written(std::vector<uint8_t>(output.begin(), output.end()), written);
+
+    std::vector<uint8_t> buffer(written.size() * 8 + 8);
+    spacker::RawOutput raw(buffer.data());
+    spacker::BitWriter writer2;
+    for (const auto& w : written) {
+        writer2.write(w.first, w.second, raw);
+    }
+    writer2.finish(raw);
+    buffer.resize(raw.size());
+    check_written(buffer, written);
+}
+
+TEST(BitWriterTest, Padding) {
+    std::vector<uint8_t> output;
+    spacker::BitWriter writer;
+    writer.write(0b101, 3, output);
+    EXPECT_EQ(writer.padding(), 5);
+    writer.pad_with_ones(output);
+    EXPECT_EQ(writer.padding(), 0);
+    writer.write(0, 62, output);
+    EXPECT_EQ(output.size(), 8);
+    EXPECT_EQ(writer.pending(), 6);
+    writer.finish(output);
+    ASSERT_EQ(output.size(), 9);
+    EXPECT_EQ(output[0], 0b10111111);
+    EXPECT_EQ(output[8], 0);
+}
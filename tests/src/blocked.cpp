@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include "spacker/pack_psip_blocked.hpp"
+#include "spacker/unpack_psip.hpp"
+#include "spacker/unpack_psip_parallel.hpp"
+#include "spacker/Multiplier.hpp"
+#include "randomize.hpp"
+
+#include <cstdint>
+#include <random>
+
+TEST(ParallelizeTest, Basic) {
+    std::vector<int> results(100);
+    spacker::parallelize(results.size(), 3, [&](size_t t) -> void {
+        results[t] = t * 2;
+    });
+    for (size_t t = 0; t < results.size(); ++t) {
+        EXPECT_EQ(results[t], t * 2);
+    }
+
+    EXPECT_ANY_THROW(spacker::parallelize(10, 3, [&](size_t t) -> void {
+        if (t == 5) {
+            throw std::runtime_error("oops");
+        }
+    }));
+}
+
+TEST(BlockBoundariesTest, Snapping) {
+    std::vector<uint32_t> input{ 1, 2, 3, 3, 3, 4, 5, 5, 5, 5, 5, 5, 5, 5, 6 };
+
+    auto bounds = spacker::choose_block_boundaries<false>(input.size(), input.data(), 3);
+    EXPECT_EQ(bounds, std::vector<size_t>({ 0, 3, 6, 9, 12, 15 }));
+
+    bounds = spacker::choose_block_boundaries<true>(input.size(), input.data(), 3);
+    EXPECT_EQ(bounds, std::vector<size_t>({ 0, 5, 8, 11, 14, 15 })); // run of 5's is too long to snap.
+
+    bounds = spacker::choose_block_boundaries<true>(input.size(), input.data(), 4);
+    EXPECT_EQ(bounds, std::vector<size_t>({ 0, 5, 9, 14, 15 }));
+}
+
+template<bool rle, class Scheme, typename T>
+void compare(const std::vector<T>& input, size_t block_size, int nthreads) {
+    auto packed = spacker::pack_psip_blocked<rle, Scheme>(input.size(), input.data(), block_size, nthreads);
+    auto table = spacker::read_block_header(packed.size(), packed.data());
+    EXPECT_EQ(table.offsets.back(), packed.size());
+    EXPECT_EQ(table.starts.back(), input.size());
+
+    std::vector<T> unpacked(input.size());
+    for (size_t b = 0; b < table.size(); ++b) {
+        auto start = table.starts[b], end = table.starts[b + 1];
+        auto ref = spacker::pack_psip<rle, Scheme>(end - start, input.data() + start);
+        EXPECT_EQ(ref, std::vector<uint8_t>(packed.begin() + table.offsets[b], packed.begin() + table.offsets[b + 1]));
+        spacker::unpack_psip<Scheme>(table.offsets[b + 1] - table.offsets[b], packed.data() + table.offsets[b], end - start, unpacked.data() + start);
+    }
+    EXPECT_EQ(input, unpacked);
+}
+
+TEST(PackBlockedTest, Basic) {
+    auto input = sparse_rle_randomize<uint32_t>(5000, 30, 1000);
+    for (size_t block_size : { 1, 100, 1000, 1000000 }) {
+        compare<true, spacker::Doubling<> >(input, block_size, 1);
+        compare<true, spacker::Doubling<> >(input, block_size, 3);
+        compare<false, spacker::Doubling<> >(input, block_size, 3);
+        compare<true, spacker::Multiplier<> >(input, block_size, 4);
+    }
+}
+
+TEST(PackBlockedTest, SingleBlock) {
+    auto input = sparse_rle_randomize<uint16_t>(1000, 30, 100);
+    auto packed = spacker::pack_psip_blocked(input.size(), input.data(), input.size(), 2);
+    auto ref = spacker::pack_psip(input.size(), input.data());
+
+    // The header is still present, but the block itself is identical to the serial output.
+    ASSERT_EQ(packed.size(), ref.size() + spacker::block_header_size(1));
+    EXPECT_EQ(std::vector<uint8_t>(packed.begin() + spacker::block_header_size(1), packed.end()), ref);
+}
+
+TEST(PackBlockedTest, Empty) {
+    std::vector<uint32_t> input;
+    auto packed = spacker::pack_psip_blocked(input.size(), input.data());
+    auto table = spacker::read_block_header(packed.size(), packed.data());
+    EXPECT_EQ(table.size(), 0);
+    EXPECT_EQ(packed.size(), spacker::block_header_size(0));
+
+    EXPECT_ANY_THROW(spacker::read_block_header(4, packed.data()));
+}
+
+template<bool rle, class Scheme, typename T>
+void compare_parallel(const std::vector<T>& input, size_t block_size, int nthreads) {
+    auto packed = spacker::pack_psip_blocked<rle, Scheme>(input.size(), input.data(), block_size, nthreads);
+    std::vector<T> unpacked(input.size());
+    spacker::unpack_psip_parallel<Scheme>(packed.size(), packed.data(), unpacked.size(), unpacked.data(), nthreads);
+    EXPECT_EQ(input, unpacked);
+}
+
+TEST(UnpackParallelTest, Basic) {
+    auto input = sparse_rle_randomize<uint32_t>(5000, 30, 1000);
+    for (size_t block_size : { 1, 100, 1000, 1000000 }) {
+        compare_parallel<true, spacker::Doubling<> >(input, block_size, 1);
+        compare_parallel<true, spacker::Doubling<> >(input, block_size, 3);
+        compare_parallel<false, spacker::Doubling<> >(input, block_size, 3);
+        compare_parallel<true, spacker::Multiplier<> >(input, block_size, 4);
+    }
+}
+
+TEST(UnpackParallelTest, Truncated) {
+    // Only unpacking the first few integers.
+    auto input = sparse_rle_randomize<uint32_t>(5000, 30, 1000);
+    auto packed = spacker::pack_psip_blocked(input.size(), input.data(), 100, 2);
+    std::vector<uint32_t> unpacked(1234);
+    spacker::unpack_psip_parallel(packed.size(), packed.data(), unpacked.size(), unpacked.data(), 2);
+    EXPECT_EQ(unpacked, std::vector<uint32_t>(input.begin(), input.begin() + unpacked.size()));
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include "spacker/pack_csc.hpp"
+#include "spacker/unpack_csc.hpp"
+#include "spacker/unpack_psip.hpp"
+#include "spacker/Multiplier.hpp"
+
+#include <cstdint>
+#include <random>
+
+struct MockCsc {
+    size_t nrow, ncol;
+    std::vector<int> p, i;
+    std::vector<double> x;
+};
+
+MockCsc simulate_csc(size_t nrow, size_t ncol, double density, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> unif;
+    MockCsc output;
+    output.nrow = nrow;
+    output.ncol = ncol;
+    output.p.push_back(0);
+    for (size_t c = 0; c < ncol; ++c) {
+        for (size_t r = 0; r < nrow; ++r) {
+            if (unif(rng) < density) {
+                output.i.push_back(r);
+                output.x.push_back(rng() % 3 == 0 ? rng() % 50 + 1 : 1);
+            }
+        }
+        output.p.push_back(output.i.size());
+    }
+    return output;
+}
+
+template<bool rle, class Scheme>
+void check_csc(const MockCsc& mat) {
+    auto packed = spacker::pack_csc<rle, Scheme>(mat.nrow, mat.ncol, mat.p.data(), mat.i.data(), mat.x.data());
+    EXPECT_EQ(packed.nrow, mat.nrow);
+    EXPECT_EQ(packed.ncol, mat.ncol);
+    EXPECT_EQ(packed.pointers.size(), mat.ncol + 1);
+    EXPECT_EQ(packed.value_offsets.back(), packed.values.size());
+    EXPECT_EQ(packed.index_offsets.back(), packed.indices.size());
+
+    std::vector<int> p(mat.ncol + 1), i(mat.i.size());
+    std::vector<double> x(mat.x.size());
+    spacker::unpack_csc<Scheme>(packed, p.data(), i.data(), x.data());
+    EXPECT_EQ(p, mat.p);
+    EXPECT_EQ(i, mat.i);
+    EXPECT_EQ(x, mat.x);
+
+    // Checking the per-column accessor.
+    for (size_t c = 0; c < mat.ncol; c += 7) {
+        size_t start = mat.p[c], len = mat.p[c + 1] - mat.p[c];
+        std::vector<int> ci(len);
+        std::vector<double> cx(len);
+        EXPECT_EQ(spacker::unpack_csc_column<Scheme>(packed, c, ci.data(), cx.data()), len);
+        EXPECT_EQ(ci, std::vector<int>(mat.i.begin() + start, mat.i.begin() + start + len));
+        EXPECT_EQ(cx, std::vector<double>(mat.x.begin() + start, mat.x.begin() + start + len));
+    }
+}
+
+TEST(CscTest, Basic) {
+    auto mat = simulate_csc(200, 50, 0.1, 42);
+    check_csc<true, spacker::Doubling<> >(mat);
+    check_csc<false, spacker::Doubling<> >(mat);
+    check_csc<true, spacker::Multiplier<> >(mat);
+
+    // Dense and empty columns.
+    auto dense = simulate_csc(100, 10, 1, 69);
+    check_csc<true, spacker::Doubling<> >(dense);
+    auto empty = simulate_csc(100, 10, 0, 69);
+    check_csc<true, spacker::Doubling<> >(empty);
+}
+
+TEST(CscTest, Contents) {
+    std::vector<int> p{ 0, 3, 3, 5 }, i{ 0, 1, 5, 2, 9 };
+    std::vector<uint32_t> x{ 1, 2, 3, 4, 5 };
+    auto packed = spacker::pack_csc(10, 3, p.data(), i.data(), x.data());
+
+    std::vector<uint32_t> deltas{ 1, 1, 4 };
+    EXPECT_EQ(
+        std::vector<uint8_t>(packed.indices.begin() + packed.index_offsets[0], packed.indices.begin() + packed.index_offsets[1]),
+        spacker::pack_psip(deltas.size(), deltas.data())
+    );
+    EXPECT_EQ(packed.index_offsets[1], packed.index_offsets[2]);
+
+    std::vector<uint32_t> values{ 4, 5 };
+    EXPECT_EQ(
+        std::vector<uint8_t>(packed.values.begin() + packed.value_offsets[2], packed.values.end()),
+        spacker::pack_psip(values.size(), values.data())
+    );
+}
+
+TEST(CscTest, OffsetPointers) {
+    // Packing a subset of columns, where the pointers do not start at zero.
+    auto mat = simulate_csc(100, 20, 0.2, 123);
+    size_t first = 5, last = 15;
+    auto packed = spacker::pack_csc(mat.nrow, last - first, mat.p.data() + first, mat.i.data(), mat.x.data());
+    EXPECT_EQ(packed.pointers.front(), 0);
+    EXPECT_EQ(packed.pointers.back(), static_cast<size_t>(mat.p[last] - mat.p[first]));
+
+    MockCsc sub;
+    sub.nrow = mat.nrow;
+    sub.ncol = last - first;
+    for (size_t c = first; c <= last; ++c) {
+        sub.p.push_back(mat.p[c] - mat.p[first]);
+    }
+    sub.i.insert(sub.i.end(), mat.i.begin() + mat.p[first], mat.i.begin() + mat.p[last]);
+    sub.x.insert(sub.x.end(), mat.x.begin() + mat.p[first], mat.x.begin() + mat.p[last]);
+
+    auto ref = spacker::pack_csc(sub.nrow, sub.ncol, sub.p.data(), sub.i.data(), sub.x.data());
+    EXPECT_EQ(packed.pointers, ref.pointers);
+    EXPECT_EQ(packed.values, ref.values);
+    EXPECT_EQ(packed.indices, ref.indices);
+
+    std::vector<int> p(sub.ncol + 1), i(sub.i.size());
+    std::vector<double> x(sub.x.size());
+    spacker::unpack_csc(packed, p.data(), i.data(), x.data());
+    EXPECT_EQ(p, sub.p);
+    EXPECT_EQ(i, sub.i);
+    EXPECT_EQ(x, sub.x);
+}
+
+TEST(CscTest, Errors) {
+    std::vector<int> p{ 0, 2 };
+    std::vector<uint32_t> x{ 1, 1 };
+
+    std::vector<int> unsorted{ 5, 2 };
+    EXPECT_ANY_THROW(spacker::pack_csc(10, 1, p.data(), unsorted.data(), x.data()));
+
+    std::vector<int> duplicated{ 2, 2 };
+    EXPECT_ANY_THROW(spacker::pack_csc(10, 1, p.data(), duplicated.data(), x.data()));
+
+    std::vector<int> outside{ 2, 10 };
+    EXPECT_ANY_THROW(spacker::pack_csc(10, 1, p.data(), outside.data(), x.data()));
+}
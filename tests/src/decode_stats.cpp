@@ -0,0 +1,24 @@
+#include <gtest/gtest.h>
+#include "spacker/pack_psip.hpp"
+#include "spacker/unpack_psip.hpp"
+#include "spacker/DecodeStats.hpp"
+
+#include <cstdint>
+
+TEST(DecodeStatsTest, Counts) {
+    std::vector<uint32_t> x{ 1, 2, 1, 1, 2, 1, 2, 2, 1, 1, 1, 2, 1, 2, 2, 1, 1000000, 7, 7 };
+    x.insert(x.end(), 100, 3);
+    auto packed = spacker::pack_psip(x.size(), x.data());
+
+    spacker::decode_stats() = spacker::DecodeStats();
+    std::vector<uint32_t> output(x.size());
+    spacker::unpack_psip(packed.size(), packed.data(), output.size(), output.data());
+    EXPECT_EQ(output, x);
+
+    const auto& stats = spacker::decode_stats();
+    EXPECT_GT(stats.short_code_bytes, 0u);
+    EXPECT_GT(stats.payload_bytes, 0u);
+    EXPECT_GT(stats.table_bytes, 0u);
+    EXPECT_EQ(stats.rle_marker_bytes, 1u);
+    EXPECT_EQ(stats.short_code_bytes + stats.payload_bytes + stats.table_bytes + stats.rle_marker_bytes, packed.size());
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include "spacker/pack_psip_deltas.hpp"
+#include "spacker/unpack_psip_deltas.hpp"
+#include "spacker/pack_psip.hpp"
+#include "spacker/Multiplier.hpp"
+
+#include <cstdint>
+#include <random>
+
+template<typename T>
+std::vector<T> sorted_randomize(size_t n, int max_gap, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<T> output;
+    T current = rng() % 10;
+    for (size_t i = 0; i < n; ++i) {
+        output.push_back(current);
+        if (rng() % 4 == 0) {
+            // Stretches of consecutive indices.
+            for (size_t j = rng() % 20; j > 0 && output.size() < n; --j) {
+                ++current;
+                output.push_back(current);
+                ++i;
+            }
+        }
+        current += rng() % max_gap + 1;
+    }
+    output.resize(n);
+    return output;
+}
+
+template<bool rle, class Scheme, typename T>
+void check_deltas(const std::vector<T>& input) {
+    auto packed = spacker::pack_psip_deltas<rle, Scheme>(input.size(), input.data());
+
+    // Same as packing the deltas directly.
+    std::vector<T> deltas(input.size());
+    for (size_t i = 0; i < input.size(); ++i) {
+        deltas[i] = input[i] - (i ? input[i - 1] : static_cast<T>(-1));
+    }
+    EXPECT_EQ(packed, (spacker::pack_psip<rle, Scheme>(deltas.size(), deltas.data())));
+
+    std::vector<T> output(input.size());
+    spacker::unpack_psip_deltas<Scheme>(packed.size(), packed.data(), output.size(), output.data());
+    EXPECT_EQ(output, input);
+}
+
+TEST(DeltasTest, Basic) {
+    std::vector<uint32_t> x{ 0, 1, 2, 3, 10, 20, 30, 31 };
+    check_deltas<true, spacker::Doubling<> >(x);
+
+    // Consecutive integers become a single RLE run.
+    std::vector<uint32_t> consecutive(1000);
+    for (size_t i = 0; i < consecutive.size(); ++i) {
+        consecutive[i] = i + 5;
+    }
+    auto packed = spacker::pack_psip_deltas(consecutive.size(), consecutive.data());
+    EXPECT_TRUE(packed.size() < 10);
+    check_deltas<true, spacker::Doubling<> >(consecutive);
+
+    std::vector<uint32_t> empty;
+    check_deltas<true, spacker::Doubling<> >(empty);
+}
+
+TEST(DeltasTest, Random) {
+    for (uint64_t seed = 1; seed <= 10; ++seed) {
+        auto x32 = sorted_randomize<uint32_t>(5000, 100, seed);
+        check_deltas<true, spacker::Doubling<> >(x32);
+        check_deltas<false, spacker::Doubling<> >(x32);
+        check_deltas<true, spacker::Multiplier<> >(x32);
+
+        auto xi = sorted_randomize<int>(5000, 20, seed);
+        check_deltas<true, spacker::Doubling<> >(xi);
+
+        auto x64 = sorted_randomize<uint64_t>(5000, 100000, seed);
+        check_deltas<true, spacker::Doubling<> >(x64);
+    }
+}
+
+TEST(DeltasTest, Truncated) {
+    auto x = sorted_randomize<uint32_t>(3000, 5, 42);
+    auto packed = spacker::pack_psip_deltas(x.size(), x.data());
+    std::vector<uint32_t> output(2000);
+    spacker::unpack_psip_deltas(packed.size(), packed.data(), output.size(), output.data());
+    EXPECT_EQ(output, std::vector<uint32_t>(x.begin(), x.begin() + 2000));
+}
+
+TEST(DeltasTest, Errors) {
+    std::vector<uint32_t> unsorted{ 5, 2 };
+    EXPECT_ANY_THROW(spacker::pack_psip_deltas(unsorted.size(), unsorted.data()));
+    std::vector<uint32_t> duplicated{ 1, 2, 3, 3 };
+    EXPECT_ANY_THROW(spacker::pack_psip_deltas(duplicated.size(), duplicated.data()));
+    std::vector<int> negative{ -1, 2 };
+    EXPECT_ANY_THROW(spacker::pack_psip_deltas(negative.size(), negative.data()));
+}
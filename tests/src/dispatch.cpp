@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include "spacker/dispatch.hpp"
+#include "spacker/pack_psip.hpp"
+
+#include <cstdint>
+#include <random>
+
+template<typename T>
+void check_dispatch(spacker::SchemeId id, const std::vector<T>& x) {
+    for (bool rle : { true, false }) {
+        auto packed = spacker::pack_psip_dispatch(id, rle, x.size(), x.data());
+        auto ref = spacker::dispatch_scheme(id, [&](auto scheme) -> std::vector<uint8_t> {
+            typedef decltype(scheme) Scheme;
+            return (rle ? spacker::pack_psip<true, Scheme>(x.size(), x.data()) : spacker::pack_psip<false, Scheme>(x.size(), x.data()));
+        });
+        EXPECT_EQ(packed, ref);
+
+        std::vector<T> output(x.size());
+        spacker::unpack_psip_dispatch(id, packed.size(), packed.data(), output.size(), output.data());
+        EXPECT_EQ(output, x);
+    }
+}
+
+TEST(DispatchTest, Basic) {
+    std::mt19937_64 rng(42);
+    std::vector<uint8_t> x8;
+    std::vector<uint16_t> x16;
+    std::vector<uint32_t> x32;
+    std::vector<uint64_t> x64;
+    for (int i = 0; i < 1000; ++i) {
+        size_t rep = (rng() % 4 == 0 ? rng() % 10 + 1 : 1);
+        x8.insert(x8.end(), rep, rng() % 20 + 1);
+        x16.insert(x16.end(), rep, rng() % 2000 + 1);
+        x32.insert(x32.end(), rep, rng() % 100000 + 1);
+        x64.insert(x64.end(), rep, rng() % 10000000 + 1);
+    }
+
+    for (auto id : spacker::all_scheme_ids) {
+        check_dispatch(id, x8);
+        check_dispatch(id, x16);
+        check_dispatch(id, x32);
+        check_dispatch(id, x64);
+    }
+}
+
+TEST(DispatchTest, Names) {
+    EXPECT_EQ(spacker::parse_scheme_id("doubling1"), spacker::SchemeId::DOUBLING_1);
+    EXPECT_EQ(spacker::parse_scheme_id("doubling4"), spacker::SchemeId::DOUBLING_4);
+    EXPECT_EQ(spacker::parse_scheme_id("multiplier8"), spacker::SchemeId::MULTIPLIER_8);
+    EXPECT_ANY_THROW(spacker::parse_scheme_id("foobar"));
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include "spacker/estimate_packed_bits.hpp"
+#include "spacker/pack_psip.hpp"
+#include "spacker/psip_aggregate.hpp"
+#include "spacker/Multiplier.hpp"
+
+#include <cstdint>
+#include <random>
+#include <cmath>
+#include <limits>
+
+template<class Scheme, typename T>
+void check_histogram(const std::vector<T>& x) {
+    auto packed = spacker::pack_psip<false, Scheme>(x.size(), x.data());
+    auto histogram = spacker::psip_histogram<Scheme>(packed.size(), packed.data(), x.size());
+    size_t bits = spacker::estimate_packed_bits<Scheme>(histogram);
+    EXPECT_EQ((bits + 7) / 8, packed.size());
+
+    // Same result with a full run summary and no RLE.
+    auto summary = spacker::summarize_runs(x.size(), x.data(), x.size());
+    EXPECT_EQ(summary.sampled, x.size());
+    EXPECT_EQ((spacker::estimate_packed_bits<false, Scheme>(summary)), bits);
+}
+
+TEST(EstimateTest, Histogram) {
+    std::mt19937_64 rng(55);
+    std::vector<uint32_t> x(10000);
+    for (auto& v : x) {
+        v = (rng() >> (40 + rng() % 24)) + 1;
+    }
+
+    check_histogram<spacker::Doubling<> >(x);
+    check_histogram<spacker::Doubling<2> >(x);
+    check_histogram<spacker::Multiplier<4> >(x);
+
+    std::vector<std::pair<uint64_t, size_t> > empty;
+    EXPECT_EQ(spacker::estimate_packed_bits(empty), 0u);
+
+    // Unrepresentable values.
+    std::vector<std::pair<uint64_t, size_t> > huge{ { std::numeric_limits<uint64_t>::max(), 1 } };
+    EXPECT_EQ(spacker::estimate_packed_bits<spacker::Multiplier<4> >(huge), std::numeric_limits<size_t>::max());
+}
+
+TEST(EstimateTest, WiderThanType) {
+    // The first class that is wider than T is zero-padded by the packer.
+    std::vector<uint16_t> x{ 1, 3000, 2 };
+    auto packed = spacker::pack_psip<false>(x.size(), x.data());
+    std::vector<std::pair<uint64_t, size_t> > histogram{ { 1, 1 }, { 2, 1 }, { 3000, 1 } };
+    size_t bits = spacker::estimate_packed_bits<spacker::Doubling<>, uint16_t>(histogram);
+    EXPECT_EQ(bits, 35u);
+    EXPECT_EQ((bits + 7) / 8, packed.size());
+    EXPECT_EQ((bits + 7) / 8, spacker::packed_size<false>(x.size(), x.data()));
+
+    // At the boundary for 64-bit integers.
+    uint64_t boundary = spacker::max<uint64_t, spacker::Doubling<>, 6>() + 1;
+    std::vector<uint64_t> y{ boundary, std::numeric_limits<uint64_t>::max() };
+    std::vector<std::pair<uint64_t, size_t> > histogram64{ { boundary, 1 }, { y.back(), 1 } };
+    bits = spacker::estimate_packed_bits(histogram64);
+    EXPECT_EQ(bits, 256u);
+    EXPECT_EQ(bits / 8, spacker::pack_psip(y.size(), y.data()).size());
+
+    // Beyond the payload of the first class that is wider than T.
+    std::vector<std::pair<uint64_t, size_t> > limit{ { 37448, 1 } };
+    EXPECT_EQ((spacker::estimate_packed_bits<spacker::Multiplier<>, uint16_t>(limit)), 20u);
+    limit[0].first = 37449;
+    EXPECT_EQ((spacker::estimate_packed_bits<spacker::Multiplier<>, uint16_t>(limit)), std::numeric_limits<size_t>::max());
+
+    auto summary = spacker::summarize_runs(x.size(), x.data());
+    EXPECT_EQ((spacker::estimate_packed_bits<true, spacker::Doubling<>, uint16_t>(summary)), 35u);
+}
+
+TEST(EstimateTest, Summary) {
+    std::vector<uint16_t> x{ 1, 1, 1, 5, 5, 1, 1, 1 };
+    auto summary = spacker::summarize_runs(x.size(), x.data());
+    EXPECT_EQ(summary.total, x.size());
+    EXPECT_EQ(summary.sampled, x.size());
+    std::vector<std::tuple<uint64_t, size_t, size_t> > expected{ { 1, 3, 2 }, { 5, 2, 1 } };
+    EXPECT_EQ(summary.runs, expected);
+
+    // Sampling chunks.
+    std::vector<uint32_t> y(100000, 1);
+    summary = spacker::summarize_runs(y.size(), y.data(), 1000, 100);
+    EXPECT_EQ(summary.sampled, 1000u);
+    std::vector<std::tuple<uint64_t, size_t, size_t> > expected2{ { 1, 100, 10 } };
+    EXPECT_EQ(summary.runs, expected2);
+}
+
+TEST(EstimateTest, Rle) {
+    std::mt19937_64 rng(56);
+    std::vector<uint32_t> x;
+    while (x.size() < 200000) {
+        size_t len = (rng() % 4 == 0 ? rng() % 100 + 1 : 1);
+        x.insert(x.end(), len, rng() % 20 + 1);
+    }
+
+    auto summary = spacker::summarize_runs(x.size(), x.data(), 20000);
+    for (int s = 0; s < 2; ++s) {
+        size_t estimated, actual;
+        if (s == 0) {
+            estimated = spacker::estimate_packed_bits<true, spacker::Doubling<> >(summary);
+            actual = spacker::packed_size<true, spacker::Doubling<> >(x.size(), x.data()) * 8;
+        } else {
+            estimated = spacker::estimate_packed_bits<true, spacker::Multiplier<4> >(summary);
+            actual = spacker::packed_size<true, spacker::Multiplier<4> >(x.size(), x.data()) * 8;
+        }
+        EXPECT_LT(std::abs(static_cast<double>(estimated) / actual - 1), 0.1);
+    }
+
+    // RLE should be estimated to be smaller than the naive encoding.
+    EXPECT_LT((spacker::estimate_packed_bits<true, spacker::Doubling<> >(summary)), (spacker::estimate_packed_bits<false, spacker::Doubling<> >(summary)));
+}
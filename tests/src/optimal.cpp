@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+#include "spacker/pack_psip_optimal.hpp"
+#include "spacker/pack_psip.hpp"
+#include "spacker/unpack_psip.hpp"
+#include "spacker/Multiplier.hpp"
+
+#include <cstdint>
+#include <random>
+
+template<class Scheme, typename T>
+size_t check_optimal(const std::vector<T>& input, size_t block_runs = 65536) {
+    auto packed = spacker::pack_psip_optimal<Scheme>(input.size(), input.data(), block_runs);
+    std::vector<T> output(input.size());
+    spacker::unpack_psip<Scheme>(packed.size(), packed.data(), output.size(), output.data());
+    EXPECT_EQ(input, output);
+    return packed.size();
+}
+
+TEST(OptimalTest, Basic) {
+    std::vector<uint32_t> x{ 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1000 };
+    size_t size = check_optimal<spacker::Doubling<> >(x);
+    EXPECT_LE(size, spacker::pack_psip(x.size(), x.data()).size());
+
+    std::vector<uint32_t> empty;
+    EXPECT_EQ(check_optimal<spacker::Doubling<> >(empty), 0u);
+
+    std::vector<uint32_t> single{ 5 };
+    EXPECT_EQ(spacker::pack_psip_optimal(single.size(), single.data()), spacker::pack_psip(single.size(), single.data()));
+}
+
+TEST(OptimalTest, MediumRuns) {
+    // Many medium-length runs, where the alignment of each RLE marker matters.
+    std::mt19937_64 rng(77);
+    size_t total_optimal = 0, total_greedy = 0;
+    for (int iter = 0; iter < 20; ++iter) {
+        std::vector<uint16_t> x;
+        while (x.size() < 20000) {
+            size_t len = (rng() % 2 ? rng() % 30 + 1 : 1);
+            x.insert(x.end(), len, rng() % (iter * 10 + 5) + 1);
+        }
+
+        size_t optimal = check_optimal<spacker::Doubling<> >(x);
+        size_t greedy = spacker::pack_psip(x.size(), x.data()).size();
+        EXPECT_LE(optimal, greedy);
+        total_optimal += optimal;
+        total_greedy += greedy;
+
+        EXPECT_LE(check_optimal<spacker::Doubling<2> >(x), (spacker::pack_psip<true, spacker::Doubling<2> >(x.size(), x.data()).size()));
+        EXPECT_LE(check_optimal<spacker::Multiplier<4> >(x), (spacker::pack_psip<true, spacker::Multiplier<4> >(x.size(), x.data()).size()));
+
+        // Small blocks are still decodable.
+        check_optimal<spacker::Doubling<> >(x, 3);
+    }
+    EXPECT_LT(total_optimal, total_greedy);
+}
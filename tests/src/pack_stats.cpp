@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include "spacker/pack_psip.hpp"
+#include "spacker/PackStats.hpp"
+#include "spacker/Multiplier.hpp"
+
+#include <cstdint>
+#include <random>
+
+TEST(PackStatsTest, Classes) {
+    std::vector<uint32_t> x{ 1, 2, 3, 4, 100, 1000, 1 };
+    spacker::PackStats stats;
+    auto packed = spacker::pack_psip<false>(x.size(), x.data(), stats);
+    EXPECT_EQ(packed, spacker::pack_psip<false>(x.size(), x.data()));
+
+    // Checking the classes against the code widths.
+    std::array<size_t, 8> expected{};
+    size_t bits = 0, multi = 0;
+    for (auto v : x) {
+        int w = spacker::code_width<spacker::Doubling<> >(v);
+        bits += w;
+        multi += (w > 8);
+        int b = 0;
+        while (spacker::Doubling<>::width(b) != w) {
+            ++b;
+        }
+        ++expected[b];
+    }
+    EXPECT_EQ(stats.classes, expected);
+    EXPECT_EQ(stats.literal_bits, bits);
+    EXPECT_EQ(stats.multi_byte_codes, multi);
+    EXPECT_DOUBLE_EQ(stats.multi_byte_share(), static_cast<double>(multi) / x.size());
+    EXPECT_EQ(stats.rle_taken, 0u);
+    EXPECT_EQ(stats.rle_rejected_approximate + stats.rle_rejected_exact, 0u);
+
+    // Counts are accumulated across calls.
+    spacker::pack_psip<false>(x.size(), x.data(), stats);
+    EXPECT_EQ(stats.literal_bits, 2 * bits);
+}
+
+TEST(PackStatsTest, Rle) {
+    std::vector<uint32_t> x{ 2 };
+    x.insert(x.end(), 100, 1); // taken.
+    x.insert(x.end(), 2, 5); // rejected by the approximate check.
+    x.insert(x.end(), 10, 1); // rejected by the exact check, after accounting for the length and padding.
+    x.insert(x.end(), 50, 3); // taken, with padding.
+
+    spacker::PackStats stats;
+    auto packed = spacker::pack_psip(x.size(), x.data(), stats);
+    EXPECT_EQ(packed, spacker::pack_psip(x.size(), x.data()));
+
+    EXPECT_EQ(stats.rle_taken, 2u);
+    EXPECT_EQ(stats.rle_rejected_approximate, 1u);
+    EXPECT_EQ(stats.rle_rejected_exact, 1u);
+    EXPECT_GT(stats.rle_padding_bits, 0u);
+
+    // Only the first literal of each encoded run is counted.
+    size_t total = 0;
+    for (auto c : stats.classes) {
+        total += c;
+    }
+    EXPECT_EQ(total, 1u + 1u + 2u + 10u + 1u);
+}
+
+TEST(PackStatsTest, Random) {
+    std::mt19937_64 rng(1000);
+    std::vector<uint16_t> x;
+    while (x.size() < 10000) {
+        x.insert(x.end(), rng() % 20 + 1, rng() % 1000 + 1);
+    }
+
+    spacker::PackStats stats;
+    auto packed = spacker::pack_psip<true, spacker::Multiplier<4> >(x.size(), x.data(), stats);
+    EXPECT_EQ(packed, (spacker::pack_psip<true, spacker::Multiplier<4> >(x.size(), x.data())));
+    EXPECT_GT(stats.rle_taken, 0u);
+    EXPECT_LE(stats.literal_bits, packed.size() * 8);
+}
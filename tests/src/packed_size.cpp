@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include "spacker/pack_psip.hpp"
+#include "spacker/Multiplier.hpp"
+#include "randomize.hpp"
+
+#include <cstdint>
+#include <random>
+
+template<bool rle, class Scheme, typename T>
+void compare(const std::vector<T>& input) {
+    auto ref = spacker::pack_psip<rle, Scheme>(input.size(), input.data());
+    EXPECT_EQ((spacker::packed_size<rle, Scheme>(input.size(), input.data())), ref.size());
+
+    // Adding an extra byte to check that we don't write past the end.
+    std::vector<uint8_t> output(ref.size() + 1, 123);
+    size_t written = spacker::pack_psip_into<rle, Scheme>(input.size(), input.data(), output.data());
+    EXPECT_EQ(written, ref.size());
+    EXPECT_EQ(output.back(), 123);
+    output.pop_back();
+    EXPECT_EQ(output, ref);
+}
+
+TEST(PackedSizeTest, Basic) {
+    EXPECT_EQ(spacker::code_width<spacker::Doubling<> >(1), 1);
+    EXPECT_EQ(spacker::code_width<spacker::Doubling<> >(2), 2);
+    EXPECT_EQ(spacker::code_width<spacker::Doubling<> >(3), 4);
+    EXPECT_EQ(spacker::code_width<spacker::Doubling<> >(20), 8);
+    EXPECT_EQ(spacker::code_width<spacker::Doubling<> >(21), 16);
+    EXPECT_EQ(spacker::code_width<spacker::Multiplier<> >(8), 4);
+    EXPECT_EQ(spacker::code_width<spacker::Multiplier<> >(9), 8);
+
+    std::vector<uint32_t> empty;
+    EXPECT_EQ(spacker::packed_size(0, empty.data()), 0);
+}
+
+TEST(PackedSizeTest, Random) {
+    for (uint64_t seed = 1; seed <= 20; ++seed) {
+        std::mt19937_64 rng(seed);
+        auto input8 = shifted_rle_randomize<uint8_t>(200, 30, 7, rng);
+        compare<true, spacker::Doubling<> >(input8);
+        compare<false, spacker::Doubling<> >(input8);
+        compare<true, spacker::Multiplier<> >(input8);
+
+        auto input32 = shifted_rle_randomize<uint32_t>(200, 30, 31, rng);
+        compare<true, spacker::Doubling<> >(input32);
+        compare<false, spacker::Doubling<> >(input32);
+        compare<true, spacker::Doubling<2> >(input32);
+
+        auto input64 = shifted_rle_randomize<uint64_t>(200, 30, 63, rng);
+        compare<true, spacker::Doubling<> >(input64);
+        compare<false, spacker::Doubling<> >(input64);
+    }
+}
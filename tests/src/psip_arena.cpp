@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "spacker/PsipArena.hpp"
+#include "spacker/pack_psip_deltas.hpp"
+#include "spacker/pack_psip_transformed.hpp"
+#include "spacker/unpack_psip.hpp"
+#include "spacker/Multiplier.hpp"
+#include "randomize.hpp"
+
+#include <cstdint>
+#include <random>
+#include <memory>
+#include <algorithm>
+
+template<bool rle, class Scheme, typename T>
+void check_arena(const std::vector<std::vector<T> >& columns) {
+    spacker::PsipArena<rle, Scheme> arena;
+    for (const auto& col : columns) {
+        arena.add(col.size(), col.data());
+    }
+    ASSERT_EQ(arena.size(), columns.size());
+    EXPECT_EQ(arena.offsets().back(), arena.data().size());
+
+    for (size_t c = 0; c < columns.size(); ++c) {
+        const auto& col = columns[c];
+        auto ref = spacker::pack_psip<rle, Scheme>(col.size(), col.data());
+        std::vector<uint8_t> observed(arena.start(c), arena.start(c) + arena.length(c));
+        EXPECT_EQ(observed, ref);
+
+        std::vector<T> unpacked(col.size());
+        spacker::unpack_psip<Scheme>(arena.length(c), arena.start(c), unpacked.size(), unpacked.data());
+        EXPECT_EQ(unpacked, col);
+    }
+}
+
+TEST(PsipArenaTest, Basic) {
+    std::mt19937_64 rng(42);
+    std::vector<std::vector<uint32_t> > columns;
+    for (int c = 0; c < 100; ++c) {
+        columns.push_back(shifted_rle_randomize<uint32_t>(rng() % 20, 10, 20, rng));
+    }
+
+    check_arena<true, spacker::Doubling<> >(columns);
+    check_arena<false, spacker::Doubling<> >(columns);
+    check_arena<true, spacker::Multiplier<> >(columns);
+}
+
+TEST(PsipArenaTest, Clear) {
+    std::vector<uint16_t> x{ 1, 2, 3, 3, 3, 3, 3, 3, 3, 3 };
+    spacker::PsipArena<> arena(100, 10);
+    arena.add(x.size(), x.data());
+    arena.add(0, x.data());
+    EXPECT_EQ(arena.size(), 2);
+    EXPECT_EQ(arena.length(1), 0);
+
+    arena.clear();
+    EXPECT_EQ(arena.size(), 0);
+    EXPECT_EQ(arena.data().size(), 0);
+    EXPECT_EQ(arena.add(x.size(), x.data()), 0);
+    EXPECT_EQ(arena.data(), spacker::pack_psip(x.size(), x.data()));
+}
+
+static size_t global_allocations = 0;
+
+template<typename T>
+struct CountingAllocator {
+    typedef T value_type;
+    CountingAllocator() = default;
+    template<typename U>
+    CountingAllocator(const CountingAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        ++global_allocations;
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T* p, size_t n) {
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    bool operator==(const CountingAllocator&) const { return true; }
+    bool operator!=(const CountingAllocator&) const { return false; }
+};
+
+TEST(PsipArenaTest, CustomOutput) {
+    typedef std::vector<uint8_t, CountingAllocator<uint8_t> > Custom;
+    std::vector<uint32_t> x{ 1, 5, 5, 5, 5, 5, 5, 100, 1000, 2 };
+
+    global_allocations = 0;
+    auto out = spacker::pack_psip<true, spacker::Doubling<>, uint32_t, Custom>(x.size(), x.data());
+    EXPECT_TRUE(global_allocations > 0);
+    auto ref = spacker::pack_psip(x.size(), x.data());
+    EXPECT_EQ(std::vector<uint8_t>(out.begin(), out.end()), ref);
+
+    // The integer type can still be specified explicitly without the output type.
+    EXPECT_EQ((spacker::pack_psip<true, spacker::Doubling<>, uint32_t>(x.size(), x.data())), ref);
+    std::vector<uint32_t> sorted(x);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    EXPECT_EQ((spacker::pack_psip_deltas<true, spacker::Doubling<>, uint32_t>(sorted.size(), sorted.data())), spacker::pack_psip_deltas(sorted.size(), sorted.data()));
+    EXPECT_EQ((spacker::pack_psip_offset<true, spacker::Doubling<>, uint32_t>(x.size(), x.data(), 0)), spacker::pack_psip_offset(x.size(), x.data(), static_cast<uint32_t>(0)));
+
+    // Reserving up front means that there are no further allocations in the arena.
+    spacker::PsipArena<true, spacker::Doubling<>, Custom> arena(ref.size() * 50);
+    global_allocations = 0;
+    for (int i = 0; i < 50; ++i) {
+        arena.add(x.size(), x.data());
+    }
+    EXPECT_EQ(global_allocations, 0);
+    EXPECT_EQ(arena.length(49), ref.size());
+}
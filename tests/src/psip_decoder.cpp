@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include "spacker/PsipDecoder.hpp"
+#include "spacker/pack_psip.hpp"
+#include "spacker/Multiplier.hpp"
+#include "randomize.hpp"
+
+#include <cstdint>
+#include <random>
+
+template<class Scheme, typename T>
+void compare(const std::vector<T>& input, size_t feed_size, size_t read_size) {
+    auto packed = spacker::pack_psip<true, Scheme>(input.size(), input.data());
+
+    spacker::PsipDecoder<Scheme, T> decoder(input.size());
+    std::vector<T> unpacked;
+    std::vector<T> buffer(read_size);
+
+    for (size_t i = 0; i < packed.size(); i += feed_size) {
+        size_t n = std::min(feed_size, packed.size() - i);
+        size_t ready = decoder.feed(n, packed.data() + i);
+        EXPECT_EQ(ready, decoder.available());
+
+        // Only reading some of the available integers, to check that the rest are preserved across feeds.
+        size_t got = decoder.read(read_size, buffer.data());
+        EXPECT_EQ(got, std::min(read_size, ready));
+        unpacked.insert(unpacked.end(), buffer.begin(), buffer.begin() + got);
+    }
+
+    while (size_t got = decoder.read(read_size, buffer.data())) {
+        unpacked.insert(unpacked.end(), buffer.begin(), buffer.begin() + got);
+    }
+
+    EXPECT_EQ(decoder.available(), 0);
+    EXPECT_EQ(input, unpacked);
+}
+
+TEST(PsipDecoderTest, Doubling) {
+    auto input = sparse_rle_randomize<uint32_t>(2000, 50, 1000);
+    for (size_t feed_size : { 1, 3, 64, 100000 }) {
+        for (size_t read_size : { 1, 10, 1000, 100000 }) {
+            compare<spacker::Doubling<> >(input, feed_size, read_size);
+        }
+    }
+}
+
+TEST(PsipDecoderTest, Multiplier) {
+    auto input = sparse_rle_randomize<uint16_t>(2000, 50, 30000);
+    for (size_t feed_size : { 1, 5, 100000 }) {
+        for (size_t read_size : { 1, 17, 100000 }) {
+            compare<spacker::Multiplier<>>(input, feed_size, read_size);
+        }
+    }
+}
+
+TEST(PsipDecoderTest, LongRuns) {
+    // RLE lengths that are split across chunks, and runs that are much longer than each chunk.
+    std::vector<uint32_t> input(100000, 7);
+    input.insert(input.end(), 3, 2);
+    input.insert(input.end(), 500000, 1);
+    input.push_back(100);
+    for (size_t feed_size : { 1, 2, 3 }) {
+        compare<spacker::Doubling<> >(input, feed_size, 1000);
+    }
+
+    // Checking that memory doesn't scale with the run length.
+    auto packed = spacker::pack_psip(input.size(), input.data());
+    spacker::PsipDecoder<> decoder(input.size());
+    EXPECT_EQ(decoder.feed(packed.size(), packed.data()), input.size());
+    std::vector<uint32_t> buffer(input.size());
+    EXPECT_EQ(decoder.read(buffer.size(), buffer.data()), input.size());
+    EXPECT_EQ(buffer, input);
+}
+
+TEST(PsipDecoderTest, Padding) {
+    // Trailing zeros are interpreted as 1's, so we need the total to ignore them.
+    std::vector<uint8_t> input{ 1, 2, 3 };
+    auto packed = spacker::pack_psip(input.size(), input.data());
+
+    spacker::PsipDecoder<spacker::Doubling<>, uint8_t> unlimited;
+    EXPECT_GT(unlimited.feed(packed.size(), packed.data()), input.size());
+
+    spacker::PsipDecoder<spacker::Doubling<>, uint8_t> limited(input.size());
+    EXPECT_EQ(limited.feed(packed.size(), packed.data()), input.size());
+}
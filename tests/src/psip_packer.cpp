@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include "spacker/PsipPacker.hpp"
+#include "spacker/pack_psip.hpp"
+#include "spacker/Multiplier.hpp"
+#include "randomize.hpp"
+
+#include <cstdint>
+#include <random>
+
+template<bool rle, class Scheme, typename T>
+void compare(const std::vector<T>& input, size_t push_size, size_t chunk_size) {
+    std::vector<uint8_t> collected;
+    size_t max_chunk = 0;
+    spacker::PsipPacker<rle, Scheme, T> packer([&](const uint8_t* ptr, size_t n) -> void {
+        collected.insert(collected.end(), ptr, ptr + n);
+        max_chunk = std::max(max_chunk, n);
+    }, chunk_size);
+
+    for (size_t i = 0; i < input.size(); i += push_size) {
+        size_t n = std::min(push_size, input.size() - i);
+        if (n == 1) {
+            packer.push(input[i]);
+        } else {
+            packer.push(n, input.data() + i);
+        }
+    }
+    packer.flush();
+
+    auto expected = spacker::pack_psip<rle, Scheme>(input.size(), input.data());
+    EXPECT_EQ(collected, expected);
+    EXPECT_LE(max_chunk, chunk_size);
+}
+
+TEST(PsipPackerTest, Doubling) {
+    auto input = rle_randomize<uint32_t>(1000, 20, 100);
+    for (size_t push_size : { 1, 3, 17, 1000, 100000 }) {
+        compare<true, spacker::Doubling<> >(input, push_size, 16);
+        compare<false, spacker::Doubling<> >(input, push_size, 16);
+        compare<true, spacker::Doubling<> >(input, push_size, 1000000);
+    }
+}
+
+TEST(PsipPackerTest, Multiplier) {
+    auto input = rle_randomize<uint16_t>(1000, 20, 10000);
+    for (size_t push_size : { 1, 5, 33, 100000 }) {
+        compare<true, spacker::Multiplier<> >(input, push_size, 7);
+        compare<false, spacker::Multiplier<> >(input, push_size, 7);
+    }
+}
+
+TEST(PsipPackerTest, LongRuns) {
+    // Runs that span many pushes.
+    std::vector<uint8_t> input(10000, 3);
+    input.insert(input.end(), 5000, 1);
+    input.push_back(20);
+    for (size_t push_size : { 1, 10, 999 }) {
+        compare<true, spacker::Doubling<> >(input, push_size, 4);
+    }
+}
+
+TEST(PsipPackerTest, Reuse) {
+    std::vector<uint8_t> collected;
+    spacker::PsipPacker<> packer([&](const uint8_t* ptr, size_t n) -> void {
+        collected.insert(collected.end(), ptr, ptr + n);
+    });
+
+    std::vector<uint32_t> input{ 1, 2, 3, 4, 5 };
+    packer.push(input.size(), input.data());
+    packer.flush();
+    auto first = collected;
+    EXPECT_EQ(first, spacker::pack_psip(input.size(), input.data()));
+
+    collected.clear();
+    packer.push(input.size(), input.data());
+    packer.flush();
+    EXPECT_EQ(first, collected);
+
+    // Flushing an empty stream does nothing.
+    collected.clear();
+    packer.flush();
+    EXPECT_TRUE(collected.empty());
+}
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include "spacker/pack_psip.hpp"
+#include "spacker/PsipRange.hpp"
+#include "spacker/Multiplier.hpp"
+
+#include <cstdint>
+#include <random>
+#include <numeric>
+
+template<bool rle, class Scheme, typename T>
+void check_range(const std::vector<T>& input) {
+    auto packed = spacker::pack_psip<rle, Scheme>(input.size(), input.data());
+    spacker::PsipRange<Scheme, T> range(packed.size(), packed.data(), input.size());
+    EXPECT_EQ(range.size(), input.size());
+
+    std::vector<T> observed;
+    for (auto x : range) {
+        observed.push_back(x);
+    }
+    EXPECT_EQ(observed, input);
+
+    // Skipping whole runs.
+    std::vector<T> by_runs;
+    for (auto it = range.begin(); it != range.end(); it.skip_run()) {
+        EXPECT_GT(it.run_length(), 0u);
+        by_runs.insert(by_runs.end(), it.run_length(), *it);
+    }
+    EXPECT_EQ(by_runs, input);
+
+    // Truncated ranges.
+    size_t half = input.size() / 2;
+    spacker::PsipRange<Scheme, T> partial(packed.size(), packed.data(), half);
+    std::vector<T> truncated(partial.begin(), partial.end());
+    EXPECT_EQ(truncated, std::vector<T>(input.begin(), input.begin() + half));
+}
+
+TEST(PsipRangeTest, Basic) {
+    std::vector<uint32_t> x{ 1, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 2, 1000, 1 };
+    check_range<true, spacker::Doubling<> >(x);
+    check_range<false, spacker::Doubling<> >(x);
+
+    std::vector<uint32_t> empty;
+    check_range<true, spacker::Doubling<> >(empty);
+}
+
+TEST(PsipRangeTest, Random) {
+    std::mt19937_64 rng(321);
+    for (int iter = 0; iter < 10; ++iter) {
+        std::vector<uint16_t> x;
+        while (x.size() < 5000) {
+            size_t len = (rng() % 5 == 0 ? rng() % 300 + 1 : 1);
+            x.insert(x.end(), len, rng() % (iter * 500 + 2) + 1);
+        }
+
+        check_range<true, spacker::Doubling<> >(x);
+        check_range<false, spacker::Doubling<> >(x);
+        check_range<true, spacker::Doubling<4> >(x);
+        check_range<true, spacker::Multiplier<4> >(x);
+    }
+}
+
+TEST(PsipRangeTest, Algorithms) {
+    std::vector<uint32_t> x(10000);
+    std::mt19937_64 rng(654);
+    for (auto& v : x) {
+        v = (rng() % 3 ? 1 : rng() % 100 + 1);
+    }
+    auto packed = spacker::pack_psip(x.size(), x.data());
+    spacker::PsipRange<> range(packed.size(), packed.data(), x.size());
+
+    uint64_t expected = 0;
+    for (auto v : x) {
+        expected += static_cast<uint64_t>(v) * v;
+    }
+    auto observed = std::transform_reduce(range.begin(), range.end(), static_cast<uint64_t>(0), std::plus<uint64_t>(), [](uint32_t v) -> uint64_t {
+        return static_cast<uint64_t>(v) * v;
+    });
+    EXPECT_EQ(observed, expected);
+}
@@ -0,0 +1,58 @@
+#ifndef RANDOMIZE_HPP
+#define RANDOMIZE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <random>
+
+// Generates 'n' runs, where each run has a random length from 1 to 'max_rep'.
+// If 'sparse = true', only one third of the runs have a random length and the rest are of length 1.
+template<typename T, class Value>
+std::vector<T> runs_randomize(size_t n, size_t max_rep, bool sparse, std::mt19937_64& rng, Value value) {
+    std::vector<T> output;
+    for (size_t i = 0; i < n; ++i) {
+        size_t num = 1;
+        if (!sparse || rng() % 3 == 0) {
+            num = rng() % max_rep + 1;
+        }
+        T val = value();
+        output.insert(output.end(), num, val);
+    }
+    return output;
+}
+
+// Runs of random length and random values from 1 to 'max_val'.
+template<typename T>
+std::vector<T> rle_randomize(size_t n, size_t max_rep, T max_val) {
+    std::mt19937_64 rng(n * max_rep * max_val);
+    return runs_randomize<T>(n, max_rep, false, rng, [&]() -> T { return rng() % max_val + 1; });
+}
+
+// Mostly single integers, with random values from 1 to 'max_val'.
+template<typename T>
+std::vector<T> sparse_rle_randomize(size_t n, size_t max_rep, T max_val) {
+    std::mt19937_64 rng(n * max_rep * max_val);
+    return runs_randomize<T>(n, max_rep, true, rng, [&]() -> T { return rng() % max_val + 1; });
+}
+
+// Mostly single integers, with values of up to 'max_shift' bits so that all code classes are represented.
+template<typename T>
+std::vector<T> shifted_rle_randomize(size_t n, size_t max_rep, int max_shift, std::mt19937_64& rng) {
+    return runs_randomize<T>(n, max_rep, true, rng, [&]() -> T { return (rng() >> (64 - (rng() % max_shift + 1))) + 1; });
+}
+
+// 'n' integers of up to 'max_shift' bits, with occasional runs of up to 50.
+template<typename T>
+std::vector<T> mixed_randomize(size_t n, int max_shift) {
+    std::mt19937_64 rng(n * max_shift);
+    std::vector<T> output;
+    while (output.size() < n) {
+        size_t num = (rng() % 4 == 0 ? rng() % 50 + 1 : 1);
+        T val = (rng() >> (64 - (rng() % max_shift + 1))) + 1;
+        output.insert(output.end(), num, val);
+    }
+    return output;
+}
+
+#endif
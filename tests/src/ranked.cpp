@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include "spacker/pack_psip_ranked.hpp"
+#include "spacker/unpack_psip_ranked.hpp"
+#include "spacker/pack_psip.hpp"
+#include "spacker/unpack_psip.hpp"
+#include "spacker/Multiplier.hpp"
+
+#include <cstdint>
+#include <random>
+
+template<bool rle, class Scheme, typename T>
+void check_ranked(const std::vector<T>& input) {
+    auto packed = spacker::pack_psip_ranked<rle, Scheme>(input.size(), input.data());
+    std::vector<T> output(input.size());
+    spacker::unpack_psip_ranked<Scheme>(packed.size(), packed.data(), output.size(), output.data());
+    EXPECT_EQ(output, input);
+}
+
+TEST(RankedTest, Dictionary) {
+    std::vector<uint32_t> x{ 5, 3, 5, 5, 3, 7, 1000000, 1000000 };
+    auto dict = spacker::rank_by_frequency(x.size(), x.data());
+    EXPECT_EQ(dict, std::vector<uint32_t>({ 5, 3, 1000000, 7 }));
+
+    // Stream is the dictionary followed by the ranks.
+    std::vector<uint32_t> expected{ 4, 5, 3, 1000000, 7, 1, 2, 1, 1, 2, 4, 3, 3 };
+    auto packed = spacker::pack_psip_ranked<false>(x.size(), x.data());
+    EXPECT_EQ(packed, spacker::pack_psip<false>(expected.size(), expected.data()));
+
+    check_ranked<true, spacker::Doubling<> >(x);
+    check_ranked<false, spacker::Doubling<> >(x);
+
+    std::vector<uint32_t> empty;
+    check_ranked<true, spacker::Doubling<> >(empty);
+}
+
+TEST(RankedTest, Poisson) {
+    std::mt19937_64 rng(42);
+    std::poisson_distribution<int> pois(10);
+    std::vector<uint32_t> x(10000);
+    for (auto& v : x) {
+        v = pois(rng) + 1;
+    }
+
+    auto ranked = spacker::pack_psip_ranked(x.size(), x.data());
+    auto naive = spacker::pack_psip(x.size(), x.data());
+    EXPECT_TRUE(ranked.size() < naive.size());
+
+    check_ranked<true, spacker::Doubling<> >(x);
+    check_ranked<true, spacker::Multiplier<> >(x);
+}
+
+TEST(RankedTest, Sparse) {
+    // Large values use a hash map instead of a dense histogram.
+    std::mt19937_64 rng(69);
+    std::vector<uint64_t> x;
+    for (int i = 0; i < 2000; ++i) {
+        uint64_t val = (rng() % 20) * 1000000007ull + 1;
+        x.insert(x.end(), rng() % 5 + 1, val);
+    }
+    check_ranked<true, spacker::Doubling<> >(x);
+    check_ranked<false, spacker::Doubling<> >(x);
+
+    std::vector<uint8_t> small{ 255, 255, 1, 2, 255 };
+    check_ranked<true, spacker::Doubling<> >(small);
+}
+
+TEST(RankedTest, Errors) {
+    // Rank of 3 with a dictionary of length 2.
+    std::vector<uint32_t> invalid{ 2, 10, 20, 1, 3 };
+    auto packed = spacker::pack_psip(invalid.size(), invalid.data());
+    std::vector<uint32_t> output(2);
+    EXPECT_ANY_THROW(spacker::unpack_psip_ranked(packed.size(), packed.data(), output.size(), output.data()));
+}
@@ -0,0 +1,214 @@
+#include <gtest/gtest.h>
+#include "spacker/simd.hpp"
+#include "spacker/pack_psip.hpp"
+#include "spacker/unpack_psip.hpp"
+#include "spacker/Multiplier.hpp"
+
+#include <cstdint>
+#include <random>
+#include <limits>
+
+TEST(SimdTest, ShortCodeBytes) {
+    EXPECT_TRUE(spacker::is_short_code_byte(0));
+    EXPECT_TRUE(spacker::is_short_code_byte(0b10101010));
+    EXPECT_TRUE(spacker::is_short_code_byte(0b01001000));
+    EXPECT_FALSE(spacker::is_short_code_byte(0b11000000));
+    EXPECT_FALSE(spacker::is_short_code_byte(0b00000001));
+    EXPECT_FALSE(spacker::is_short_code_byte(0b11111111));
+
+    std::mt19937_64 rng(42);
+    std::vector<uint8_t> short_bytes;
+    for (int v = 0; v < 256; ++v) {
+        if (spacker::is_short_code_byte(v)) {
+            short_bytes.push_back(v);
+        }
+    }
+
+    for (size_t len = 0; len < 200; len += 7) {
+        std::vector<uint8_t> input(len + 50);
+        for (size_t i = 0; i < len; ++i) {
+            input[i] = short_bytes[rng() % short_bytes.size()];
+        }
+        input[len] = 0b11000000;
+
+        EXPECT_EQ(spacker::count_short_code_bytes_scalar(input.size(), input.data()), len);
+        EXPECT_EQ(spacker::count_short_code_bytes(input.size(), input.data()), len);
+        EXPECT_EQ(spacker::count_short_code_bytes(len, input.data()), len);
+    }
+}
+
+TEST(SimdTest, UnpackShortCodes) {
+    std::mt19937_64 rng(100);
+    for (int iter = 0; iter < 20; ++iter) {
+        // Mostly 1's and 2's, interrupted by larger values and runs.
+        std::vector<uint32_t> input;
+        for (int i = 0; i < 10000; ++i) {
+            auto choice = rng() % 100;
+            if (choice == 0) {
+                input.insert(input.end(), rng() % 100 + 1, rng() % 2 + 1);
+            } else if (choice == 1) {
+                input.push_back(rng() % 250 + 1);
+            } else {
+                input.push_back(rng() % 2 + 1);
+            }
+        }
+        input.resize(input.size() - iter); // tail shouldn't be a multiple of anything.
+
+        auto packed = spacker::pack_psip(input.size(), input.data());
+        std::vector<uint32_t> unpacked(input.size());
+        spacker::unpack_psip(packed.size(), packed.data(), unpacked.size(), unpacked.data());
+        EXPECT_EQ(input, unpacked);
+
+        auto unpacked8 = std::vector<uint8_t>(input.size());
+        std::vector<uint8_t> input8(input.begin(), input.end());
+        packed = spacker::pack_psip(input8.size(), input8.data());
+        spacker::unpack_psip(packed.size(), packed.data(), unpacked8.size(), unpacked8.data());
+        EXPECT_EQ(input8, unpacked8);
+    }
+}
+
+TEST(SimdTest, PrefixSum) {
+    std::mt19937_64 rng(69);
+    for (size_t len = 0; len < 100; len += 3) {
+        std::vector<uint32_t> input(len);
+        for (auto& x : input) {
+            x = rng() % 1000;
+        }
+
+        auto expected = input;
+        uint32_t expected_carry = spacker::prefix_sum_scalar(expected.size(), expected.data(), static_cast<uint32_t>(5));
+        auto observed = input;
+        uint32_t observed_carry = spacker::prefix_sum(observed.size(), observed.data(), static_cast<uint32_t>(5));
+        EXPECT_EQ(expected, observed);
+        EXPECT_EQ(expected_carry, observed_carry);
+
+        // Signed integers use the same kernel.
+        std::vector<int32_t> signed_input(input.begin(), input.end());
+        spacker::prefix_sum(signed_input.size(), signed_input.data(), static_cast<int32_t>(-1));
+        for (size_t i = 0; i < len; ++i) {
+            EXPECT_EQ(signed_input[i], static_cast<int32_t>(expected[i]) - 6);
+        }
+    }
+}
+
+template<typename T>
+void check_count_run() {
+    std::mt19937_64 rng(sizeof(T));
+    for (size_t len = 1; len < 150; len += 5) {
+        for (size_t extra = 0; extra < 3; ++extra) {
+            std::vector<T> input(len, 7);
+            if (extra) {
+                input.resize(len + extra * 20);
+                for (size_t i = len; i < input.size(); ++i) {
+                    input[i] = 8 + rng() % 5;
+                }
+            }
+            EXPECT_EQ(spacker::count_run_scalar(input.size(), input.data()), len);
+            EXPECT_EQ(spacker::count_run(input.size(), input.data()), len);
+        }
+    }
+}
+
+TEST(SimdTest, CountRun) {
+    check_count_run<uint8_t>();
+    check_count_run<uint16_t>();
+    check_count_run<uint32_t>();
+    check_count_run<uint64_t>();
+    check_count_run<int32_t>();
+}
+
+template<typename T>
+void check_mismatches() {
+    std::mt19937_64 rng(77);
+    for (int it = 0; it < 200; ++it) {
+        std::vector<T> input(8);
+        T val = rng() % 3 + 1;
+        for (auto& x : input) {
+            x = rng() % 3 + 1;
+        }
+        unsigned expected = spacker::find_mismatches_scalar(input.data(), val);
+        EXPECT_EQ(spacker::find_mismatches(input.data(), val), expected);
+        for (int k = 0; k < 8; ++k) {
+            EXPECT_EQ((expected >> k) & 1, static_cast<unsigned>(input[k] != val));
+        }
+    }
+
+    // Differences in the upper bits are detected.
+    std::vector<T> input(8, 1);
+    input[5] = static_cast<T>(1) | (static_cast<T>(1) << (std::numeric_limits<T>::digits - 1));
+    EXPECT_EQ(spacker::find_mismatches(input.data(), static_cast<T>(1)), 1u << 5);
+}
+
+TEST(SimdTest, Mismatches) {
+    check_mismatches<uint8_t>();
+    check_mismatches<uint16_t>();
+    check_mismatches<uint32_t>();
+    check_mismatches<uint64_t>();
+    check_mismatches<int16_t>();
+}
+
+template<class Scheme>
+void reference_code(uint64_t val, std::vector<bool>& bits) {
+    // Writing each bit separately, without using the code class tables.
+    int preamble = 0;
+    uint64_t lower = 1;
+    while (true) {
+        uint64_t capacity = static_cast<uint64_t>(1) << (Scheme::width(preamble) - preamble - 1);
+        if (val - lower < capacity) {
+            break;
+        }
+        lower += capacity;
+        ++preamble;
+    }
+
+    bits.insert(bits.end(), preamble, true);
+    bits.push_back(false);
+    int payload = Scheme::width(preamble) - preamble - 1;
+    for (int b = payload - 1; b >= 0; --b) {
+        bits.push_back((((val - lower) >> b) & 1) != 0);
+    }
+}
+
+template<class Scheme>
+void check_repeated_codes() {
+    for (uint32_t val : std::vector<uint32_t>{ 1, 2, 3, 5, 20, 100, 999 }) {
+        int required = spacker::code_width<Scheme>(val);
+        size_t per_word = 64 / required;
+
+        for (size_t count : std::vector<size_t>{ 2, per_word - 1, per_word, per_word + 1, 3 * per_word + 2, 100 }) {
+            // Trying all positions within the accumulator, including byte-aligned and unaligned starts.
+            for (int offset = 0; offset < 64; ++offset) {
+                uint64_t leading = 0x5555555555555555 & ((static_cast<uint64_t>(1) << offset) - 1);
+                std::vector<uint8_t> observed;
+                spacker::BitWriter writer;
+                writer.write(leading, offset, observed);
+                spacker::pack_psip_repeat<Scheme>(val, required, count, writer, observed);
+                writer.finish(observed);
+
+                std::vector<bool> bits;
+                for (int b = offset - 1; b >= 0; --b) {
+                    bits.push_back(((leading >> b) & 1) != 0);
+                }
+                for (size_t c = 0; c < count; ++c) {
+                    reference_code<Scheme>(val, bits);
+                }
+                while (bits.size() % 8) {
+                    bits.push_back(false);
+                }
+
+                std::vector<uint8_t> expected(bits.size() / 8);
+                for (size_t b = 0; b < bits.size(); ++b) {
+                    expected[b / 8] |= static_cast<uint8_t>(bits[b]) << (7 - b % 8);
+                }
+                ASSERT_EQ(observed, expected);
+            }
+        }
+    }
+}
+
+TEST(SimdTest, RepeatedCodes) {
+    // Large counts of short codes are written a word at a time.
+    check_repeated_codes<spacker::Doubling<> >();
+    check_repeated_codes<spacker::Doubling<2> >();
+    check_repeated_codes<spacker::Multiplier<4> >();
+}
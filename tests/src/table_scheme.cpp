@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include "spacker/TableScheme.hpp"
+#include "spacker/train_table_widths.hpp"
+#include "spacker/pack_psip.hpp"
+#include "spacker/unpack_psip.hpp"
+#include "spacker/unpack_psip_wide.hpp"
+#include "spacker/Multiplier.hpp"
+#include "spacker/SchemeId.hpp"
+
+#include <cstdint>
+#include <random>
+
+typedef spacker::TableScheme<1, 2, 4, 8, 16, 32, 64, 128> DoublingTable;
+typedef spacker::TableScheme<2, 3, 4, 8, 12, 16, 24, 40> CustomTable;
+
+TEST(TableSchemeTest, Validity) {
+    EXPECT_TRUE(spacker::valid_table_widths({ 1, 2, 4, 8, 16, 32, 64, 128 }));
+    EXPECT_TRUE(spacker::valid_table_widths({ 2, 3, 4, 8, 12, 16, 24, 40 }));
+    EXPECT_FALSE(spacker::valid_table_widths({ 1, 1, 4, 8, 16, 32, 64, 128 })); // no space for the preamble.
+    EXPECT_FALSE(spacker::valid_table_widths({ 1, 12, 4, 8, 16, 32, 64, 128 })); // single-byte code after a multi-byte code.
+    EXPECT_TRUE(spacker::valid_table_widths({ 1, 2, 4, 10, 16, 32, 64, 128 })); // multi-byte code with a small payload.
+    EXPECT_FALSE(spacker::valid_table_widths({ 1, 2, 3, 4, 5, 6, 7, 8 })); // no multi-byte code.
+
+    EXPECT_EQ(DoublingTable::max_bits_per_byte(), spacker::Doubling<1>::max_bits_per_byte());
+    EXPECT_EQ(CustomTable::max_bits_per_byte(), 3);
+    EXPECT_EQ((spacker::max<uint32_t, DoublingTable, 5>()), (spacker::max<uint32_t, spacker::Doubling<1>, 5>()));
+    EXPECT_EQ((spacker::min<uint32_t, CustomTable, 1>()), 3);
+    EXPECT_FALSE((spacker::supports<uint16_t, CustomTable, 6>()));
+
+    // Packing stops at the first class that is wider than the integer type.
+    EXPECT_EQ(spacker::table_max_packable<uint32_t>({ 1, 2, 4, 8, 16, 32, 64, 128 }), std::numeric_limits<uint32_t>::max());
+    EXPECT_EQ(spacker::table_max_packable<uint16_t>({ 2, 3, 4, 8, 12, 16, 24, 40 }), (spacker::max_packable<uint16_t, CustomTable>()));
+    EXPECT_EQ(spacker::table_max_packable<uint32_t>({ 2, 3, 4, 8, 12, 16, 24, 40 }), (spacker::max_packable<uint32_t, CustomTable>()));
+    typedef spacker::TableScheme<1, 2, 4, 8, 16, 33, 40, 64> Truncated;
+    EXPECT_EQ(spacker::table_max_packable<uint32_t>({ 1, 2, 4, 8, 16, 33, 40, 64 }), (spacker::max_packable<uint32_t, Truncated>()));
+    EXPECT_TRUE(spacker::valid_table_widths({ 1, 2, 4, 8, 16, 33, 40, 64 }));
+    EXPECT_FALSE(spacker::valid_table_widths<uint32_t>({ 1, 2, 4, 8, 16, 33, 40, 64 }));
+    EXPECT_TRUE(spacker::valid_table_widths<uint32_t>({ 1, 2, 4, 8, 16, 33, 40, 64 }, 30000000));
+    EXPECT_TRUE(spacker::valid_table_widths<uint64_t>({ 1, 2, 4, 8, 16, 33, 40, 64 }, 300000000));
+    EXPECT_TRUE(spacker::valid_table_widths<uint32_t>({ 1, 2, 4, 8, 16, 32, 64, 128 }));
+    EXPECT_FALSE(spacker::valid_table_widths<uint64_t>({ 2, 3, 4, 8, 12, 16, 24, 40 }));
+}
+
+TEST(TableSchemeTest, RoundTrip) {
+    std::mt19937_64 rng(42);
+    std::vector<uint32_t> x;
+    for (int i = 0; i < 2000; ++i) {
+        uint32_t val = (rng() >> (64 - (rng() % 30 + 1))) + 1;
+        x.insert(x.end(), (rng() % 5 == 0 ? rng() % 20 + 1 : 1), val);
+    }
+
+    EXPECT_EQ((spacker::pack_psip<true, DoublingTable>(x.size(), x.data())), (spacker::pack_psip<true, spacker::Doubling<1> >(x.size(), x.data())));
+
+    auto packed = spacker::pack_psip<true, CustomTable>(x.size(), x.data());
+    std::vector<uint32_t> output(x.size());
+    spacker::unpack_psip<CustomTable>(packed.size(), packed.data(), output.size(), output.data());
+    EXPECT_EQ(output, x);
+
+    std::vector<uint32_t> output2(x.size());
+    spacker::unpack_psip_wide<CustomTable>(packed.size(), packed.data(), output2.size(), output2.data());
+    EXPECT_EQ(output2, x);
+
+    std::vector<uint64_t> x64(x.begin(), x.end());
+    auto packed64 = spacker::pack_psip<false, CustomTable>(x64.size(), x64.data());
+    std::vector<uint64_t> output64(x64.size());
+    spacker::unpack_psip<CustomTable>(packed64.size(), packed64.data(), output64.size(), output64.data());
+    EXPECT_EQ(output64, x64);
+}
+
+TEST(TableSchemeTest, Training) {
+    std::vector<std::pair<uint64_t, size_t> > histogram{ { 1, 10 }, { 2, 5 }, { 5, 1 } };
+    EXPECT_EQ(spacker::table_packed_bits({ 1, 2, 4, 8, 16, 32, 64, 128 }, histogram), 10 * 1 + 5 * 2 + 8);
+    EXPECT_EQ(spacker::table_packed_bits({ 4, 8, 12, 16, 20, 24, 28, 32 }, { { 1ull << 60, 1 } }), std::numeric_limits<size_t>::max());
+
+    // Counts with a large mean.
+    std::mt19937_64 rng(69);
+    std::poisson_distribution<int> pois(10);
+    std::vector<uint32_t> sample(10000);
+    for (auto& s : sample) {
+        s = pois(rng) + 1;
+    }
+
+    auto widths = spacker::train_table_widths(sample.size(), sample.data());
+    EXPECT_TRUE(spacker::valid_table_widths(widths));
+
+    std::vector<std::pair<uint64_t, size_t> > hist;
+    for (auto s : sample) {
+        hist.emplace_back(s, 1);
+    }
+    std::sort(hist.begin(), hist.end());
+    auto trained = spacker::table_packed_bits(widths, hist);
+    EXPECT_TRUE(trained < spacker::table_packed_bits({ 1, 2, 4, 8, 16, 32, 64, 128 }, hist));
+    EXPECT_TRUE(trained < spacker::table_packed_bits({ 4, 8, 12, 16, 20, 24, 28, 32 }, hist));
+
+    // Non-monotonic widths are still valid.
+    typedef spacker::TableScheme<4, 4, 4, 5, 8, 8, 7, 15> Irregular;
+    std::vector<uint32_t> clipped;
+    for (auto s : sample) {
+        clipped.push_back(std::min(s, static_cast<uint32_t>(30)));
+    }
+    auto packed = spacker::pack_psip<true, Irregular>(clipped.size(), clipped.data());
+    std::vector<uint32_t> output(clipped.size());
+    spacker::unpack_psip<Irregular>(packed.size(), packed.data(), output.size(), output.data());
+    EXPECT_EQ(output, clipped);
+
+    // The limit is respected.
+    auto limited = spacker::train_table_widths(sample.size(), sample.data(), 1000000);
+    EXPECT_TRUE(spacker::table_class_bounds(limited)[7] >= 1000000);
+    EXPECT_TRUE(spacker::table_max_packable<uint32_t>(limited) >= 1000000);
+
+    // Trivial cases.
+    std::vector<uint32_t> ones(100, 1);
+    auto one_widths = spacker::train_table_widths(ones.size(), ones.data());
+    EXPECT_EQ(one_widths[0], 1);
+    EXPECT_ANY_THROW(spacker::train_table_widths<uint32_t>(hist, 1ull << 40));
+}
+
+TEST(TableSchemeTest, TrainingHeavyTail) {
+    // Mostly small integers with a tail of values close to 2^32, which are only representable if training accounts for the type.
+    std::mt19937_64 rng(1234);
+    std::vector<uint32_t> sample;
+    for (int i = 0; i < 10000; ++i) {
+        if (rng() % 50 == 0) {
+            sample.push_back(std::numeric_limits<uint32_t>::max() - rng() % 100000000);
+        } else {
+            sample.push_back((rng() >> (64 - (rng() % 12 + 1))) + 1);
+        }
+    }
+    auto largest = *std::max_element(sample.begin(), sample.end());
+
+    auto widths = spacker::train_table_widths(sample.size(), sample.data());
+    EXPECT_TRUE(spacker::valid_table_widths<uint32_t>(widths, largest));
+    EXPECT_TRUE(spacker::table_max_packable<uint32_t>(widths) >= largest);
+
+    // Widths from the training above, hard-coded so that they can be used as template arguments.
+    std::array<int, 8> expected{ 5, 9, 13, 15, 15, 38, 28, 9 };
+    EXPECT_EQ(widths, expected);
+    typedef spacker::TableScheme<5, 9, 13, 15, 15, 38, 28, 9> Trained;
+    EXPECT_TRUE((spacker::max_packable<uint32_t, Trained>()) >= largest);
+
+    auto packed = spacker::pack_psip<true, Trained>(sample.size(), sample.data());
+    std::vector<uint32_t> output(sample.size());
+    spacker::unpack_psip<Trained>(packed.size(), packed.data(), output.size(), output.data());
+    EXPECT_EQ(output, sample);
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include "spacker/pack_psip_transformed.hpp"
+#include "spacker/unpack_psip_transformed.hpp"
+#include "spacker/pack_psip.hpp"
+#include "spacker/Multiplier.hpp"
+#include "randomize.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <random>
+
+template<typename T>
+std::vector<T> signed_randomize(size_t n, size_t max_rep, int max_shift, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    return runs_randomize<T>(n, max_rep, true, rng, [&]() -> T {
+        T val = static_cast<T>(rng() >> (64 - (rng() % max_shift + 1)));
+        return (rng() % 2 ? -val : val);
+    });
+}
+
+TEST(TransformTest, Zigzag) {
+    EXPECT_EQ(spacker::Zigzag<int>::forward(0), 1);
+    EXPECT_EQ(spacker::Zigzag<int>::forward(-1), 2);
+    EXPECT_EQ(spacker::Zigzag<int>::forward(1), 3);
+    EXPECT_EQ(spacker::Zigzag<int>::forward(-2), 4);
+
+    std::vector<int32_t> extremes{ 0, -1, 1, std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max() };
+    for (auto x : extremes) {
+        EXPECT_EQ(spacker::Zigzag<int32_t>::reverse(spacker::Zigzag<int32_t>::forward(x)), x);
+    }
+    EXPECT_EQ(spacker::Zigzag<int8_t>::reverse(spacker::Zigzag<int8_t>::forward(-128)), -128);
+    EXPECT_EQ(spacker::Zigzag<int64_t>::reverse(spacker::Zigzag<int64_t>::forward(-5)), -5);
+}
+
+TEST(TransformTest, Offset) {
+    spacker::Offset<int> off(-10);
+    EXPECT_EQ(off.forward(-10), 1);
+    EXPECT_EQ(off.forward(0), 11);
+    EXPECT_EQ(off.reverse(11), 0);
+
+    spacker::Offset<uint32_t> zero;
+    EXPECT_EQ(zero.forward(0), 1);
+    EXPECT_EQ(zero.reverse(1), 0);
+}
+
+template<bool rle, class Scheme, typename T>
+void check_zigzag(const std::vector<T>& input) {
+    auto packed = spacker::pack_psip_zigzag<rle, Scheme>(input.size(), input.data());
+
+    std::vector<uint64_t> codes;
+    for (auto x : input) {
+        codes.push_back(spacker::Zigzag<T>::forward(x));
+    }
+    EXPECT_EQ(packed, (spacker::pack_psip<rle, Scheme>(codes.size(), codes.data())));
+
+    std::vector<T> output(input.size());
+    spacker::unpack_psip_zigzag<Scheme>(packed.size(), packed.data(), output.size(), output.data());
+    EXPECT_EQ(output, input);
+}
+
+TEST(TransformTest, PackZigzag) {
+    for (uint64_t seed = 1; seed <= 10; ++seed) {
+        auto x32 = signed_randomize<int32_t>(500, 20, 20, seed);
+        check_zigzag<true, spacker::Doubling<> >(x32);
+        check_zigzag<false, spacker::Doubling<> >(x32);
+        check_zigzag<true, spacker::Multiplier<> >(x32);
+
+        auto x64 = signed_randomize<int64_t>(500, 20, 62, seed);
+        check_zigzag<true, spacker::Doubling<> >(x64);
+
+        auto x8 = signed_randomize<int8_t>(500, 20, 7, seed);
+        check_zigzag<true, spacker::Doubling<> >(x8);
+    }
+}
+
+TEST(TransformTest, PackOffset) {
+    std::mt19937_64 rng(42);
+    std::vector<uint32_t> counts;
+    for (int i = 0; i < 1000; ++i) {
+        counts.insert(counts.end(), rng() % 3 + 1, rng() % 5);
+    }
+
+    auto packed = spacker::pack_psip_offset(counts.size(), counts.data(), static_cast<uint32_t>(0));
+    std::vector<uint32_t> output(counts.size());
+    spacker::unpack_psip_offset(packed.size(), packed.data(), output.size(), output.data(), static_cast<uint32_t>(0));
+    EXPECT_EQ(output, counts);
+
+    std::vector<int> shifted;
+    for (auto c : counts) {
+        shifted.push_back(static_cast<int>(c) - 3);
+    }
+    auto packed2 = spacker::pack_psip_offset<false>(shifted.size(), shifted.data(), -3);
+    EXPECT_EQ(packed2, (spacker::pack_psip_offset<false>(counts.size(), counts.data(), static_cast<uint32_t>(0))));
+    std::vector<int> output2(shifted.size());
+    spacker::unpack_psip_offset(packed2.size(), packed2.data(), output2.size(), output2.data(), -3);
+    EXPECT_EQ(output2, shifted);
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include "spacker/pack_psip.hpp"
 #include "spacker/unpack_psip.hpp"
+#include "randomize.hpp"
 
 #include <cstdint>
 #include <limits>
@@ -171,18 +172,6 @@ TEST(UnpackDoublingTest, RandomUint32) {
 
 /** Randomized tests, with rle's ***/
 
-template<typename T>
-std::vector<T> rle_randomize(size_t n, size_t max_rep, T max_val) {
-    std::mt19937_64 rng(n * max_rep * max_val);
-    std::vector<T> output;
-    for (size_t i = 0; i < n; ++i) {
-        size_t num = rng() % max_rep + 1;
-        T val = rng() % max_val + 1;
-        output.insert(output.end(), num, val);
-    }
-    return output;
-}
-
 TEST(UnpackDoublingTest, RleUint8) {
     auto output = rle_randomize<uint8_t>(10, 20, 2);
     compare<true>(output);
@@ -236,3 +225,17 @@ TEST(UnpackDoublingTest, RleUint32) {
     output = rle_randomize<uint32_t>(10, 20, 1000000);
     compare<true>(output);
 }
+
+/** Randomized tests with mixed magnitudes ***/
+
+TEST(UnpackDoublingTest, MixedUint32) {
+    auto output = mixed_randomize<uint32_t>(1000, 31);
+    compare<false>(output);
+    compare<true>(output);
+}
+
+TEST(UnpackDoublingTest, MixedUint64) {
+    auto output = mixed_randomize<uint64_t>(1000, 63);
+    compare<false>(output);
+    compare<true>(output);
+}
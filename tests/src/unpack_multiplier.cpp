@@ -2,6 +2,7 @@
 #include "spacker/pack_psip.hpp"
 #include "spacker/unpack_psip.hpp"
 #include "spacker/Multiplier.hpp"
+#include "randomize.hpp"
 
 #include <cstdint>
 #include <limits>
@@ -172,18 +173,6 @@ TEST(UnpackMultiplierTest, RandomUint32) {
 
 /** Randomized tests, with rle's ***/
 
-template<typename T>
-std::vector<T> rle_randomize(size_t n, size_t max_rep, T max_val) {
-    std::mt19937_64 rng(n * max_rep * max_val);
-    std::vector<T> output;
-    for (size_t i = 0; i < n; ++i) {
-        size_t num = rng() % max_rep + 1;
-        T val = rng() % max_val + 1;
-        output.insert(output.end(), num, val);
-    }
-    return output;
-}
-
 TEST(UnpackMultiplierTest, RleUint8) {
     auto output = rle_randomize<uint8_t>(10, 20, 2);
     compare<true>(output);
@@ -237,3 +226,18 @@ TEST(UnpackMultiplierTest, RleUint32) {
     output = rle_randomize<uint32_t>(10, 20, 1000000);
     compare<true>(output);
 }
+
+/** Randomized tests with mixed magnitudes ***/
+
+TEST(UnpackMultiplierTest, MixedUint16) {
+    auto output = mixed_randomize<uint16_t>(1000, 15);
+    compare<false>(output);
+    compare<true>(output);
+}
+
+TEST(UnpackMultiplierTest, MixedUint32) {
+    // Multiplier<4> caps out at 7 preamble bits, i.e., 24 payload bits.
+    auto output = mixed_randomize<uint32_t>(1000, 23);
+    compare<false>(output);
+    compare<true>(output);
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include "spacker/pack_psip.hpp"
+#include "spacker/unpack_psip_range.hpp"
+#include "spacker/Multiplier.hpp"
+#include "randomize.hpp"
+
+#include <cstdint>
+#include <random>
+
+TEST(SeekIndexTest, Points) {
+    std::vector<uint32_t> input(100);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = i % 5 + 1;
+    }
+
+    spacker::SeekIndex index(10);
+    auto packed = spacker::pack_psip(input.size(), input.data(), index);
+    EXPECT_EQ(packed, spacker::pack_psip(input.size(), input.data()));
+
+    // No runs, so every point should be exactly at the interval.
+    ASSERT_EQ(index.points.size(), 9);
+    for (size_t p = 0; p < index.points.size(); ++p) {
+        EXPECT_EQ(index.points[p].count, (p + 1) * 10);
+        EXPECT_LT(index.points[p].bit, 8);
+    }
+
+    // Points are skipped inside runs.
+    input = std::vector<uint32_t>(100, 2);
+    input.push_back(5);
+    packed = spacker::pack_psip(input.size(), input.data(), index);
+    ASSERT_EQ(index.points.size(), 1);
+    EXPECT_EQ(index.points[0].count, 100);
+}
+
+template<bool rle, class Scheme, typename T>
+void compare(const std::vector<T>& input, size_t interval) {
+    spacker::SeekIndex index(interval);
+    auto packed = spacker::pack_psip<rle, Scheme>(input.size(), input.data(), index);
+
+    std::mt19937_64 rng(input.size() * interval);
+    for (int it = 0; it < 50; ++it) {
+        size_t start = rng() % input.size();
+        size_t end = std::min(input.size(), start + rng() % 200);
+        std::vector<T> output(end - start);
+        spacker::unpack_psip_range<Scheme>(packed.size(), packed.data(), index, start, end, output.data());
+        EXPECT_EQ(output, std::vector<T>(input.begin() + start, input.begin() + end));
+    }
+
+    // Full range.
+    std::vector<T> output(input.size());
+    spacker::unpack_psip_range<Scheme>(packed.size(), packed.data(), index, 0, input.size(), output.data());
+    EXPECT_EQ(output, input);
+}
+
+TEST(UnpackRangeTest, Doubling) {
+    auto input = sparse_rle_randomize<uint32_t>(2000, 30, 1000);
+    for (size_t interval : { 1, 7, 100, 100000 }) {
+        compare<true, spacker::Doubling<> >(input, interval);
+        compare<false, spacker::Doubling<> >(input, interval);
+    }
+}
+
+TEST(UnpackRangeTest, Multiplier) {
+    auto input = sparse_rle_randomize<uint16_t>(2000, 30, 30000);
+    for (size_t interval : { 1, 13, 1000 }) {
+        compare<true, spacker::Multiplier<> >(input, interval);
+        compare<false, spacker::Multiplier<> >(input, interval);
+    }
+}
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include "spacker/pack_psip.hpp"
+#include "spacker/unpack_psip_runs.hpp"
+#include "spacker/Multiplier.hpp"
+
+#include <cstdint>
+#include <random>
+
+template<typename T>
+std::vector<std::pair<T, size_t> > reference_runs(size_t n, const T* input) {
+    std::vector<std::pair<T, size_t> > output;
+    for (size_t i = 0; i < n; ++i) {
+        if (!output.empty() && output.back().first == input[i]) {
+            ++output.back().second;
+        } else {
+            output.emplace_back(input[i], 1);
+        }
+    }
+    return output;
+}
+
+template<bool rle, class Scheme, typename T>
+void check_runs(const std::vector<T>& input) {
+    auto packed = spacker::pack_psip<rle, Scheme>(input.size(), input.data());
+    auto runs = spacker::unpack_psip_runs<Scheme, T>(packed.size(), packed.data(), input.size());
+    EXPECT_EQ(runs, reference_runs(input.size(), input.data()));
+
+    // Truncating the number of integers.
+    size_t half = input.size() / 2;
+    auto partial = spacker::unpack_psip_runs<Scheme, T>(packed.size(), packed.data(), half);
+    EXPECT_EQ(partial, reference_runs(half, input.data()));
+}
+
+TEST(UnpackRunsTest, Basic) {
+    std::vector<uint32_t> x{ 1, 1, 1, 2, 2, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 1 };
+    auto packed = spacker::pack_psip(x.size(), x.data());
+    auto runs = spacker::unpack_psip_runs(packed.size(), packed.data(), x.size());
+    std::vector<std::pair<uint32_t, size_t> > expected{ { 1, 3 }, { 2, 2 }, { 5, 14 }, { 1, 1 } };
+    EXPECT_EQ(runs, expected);
+
+    check_runs<true, spacker::Doubling<> >(x);
+    check_runs<false, spacker::Doubling<> >(x);
+
+    std::vector<uint32_t> empty;
+    check_runs<true, spacker::Doubling<> >(empty);
+}
+
+TEST(UnpackRunsTest, Random) {
+    std::mt19937_64 rng(123);
+    for (int iter = 0; iter < 10; ++iter) {
+        std::vector<uint16_t> x;
+        while (x.size() < 5000) {
+            size_t len = (rng() % 5 == 0 ? rng() % 200 + 1 : 1);
+            x.insert(x.end(), len, rng() % (iter * 100 + 3) + 1);
+        }
+
+        check_runs<true, spacker::Doubling<> >(x);
+        check_runs<false, spacker::Doubling<> >(x);
+        check_runs<true, spacker::Doubling<2> >(x);
+        check_runs<true, spacker::Multiplier<8> >(x);
+    }
+}
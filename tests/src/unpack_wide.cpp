@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include "spacker/pack_psip.hpp"
+#include "spacker/unpack_psip.hpp"
+#include "spacker/unpack_psip_wide.hpp"
+#include "spacker/Multiplier.hpp"
+#include "randomize.hpp"
+
+#include <cstdint>
+#include <algorithm>
+#include <random>
+
+TEST(BitReaderTest, Basic) {
+    std::vector<uint8_t> input(20);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = i * 17;
+    }
+
+    // Reading 3 bits at a time and comparing to a naive extraction.
+    for (size_t start = 0; start < 8; ++start) {
+        spacker::BitReader reader(input.size(), input.data(), start);
+        for (size_t pos = start; pos + 3 <= input.size() * 8; pos += 3) {
+            EXPECT_EQ(reader.position(), pos);
+            reader.refill();
+            EXPECT_TRUE(reader.available() >= static_cast<int>(std::min(static_cast<size_t>(56), input.size() * 8 - pos)));
+            uint64_t expected = 0;
+            for (size_t b = pos; b < pos + 3; ++b) {
+                expected <<= 1;
+                expected |= (input[b / 8] >> (7 - b % 8)) & 1;
+            }
+            EXPECT_EQ(reader.read(3), expected);
+        }
+    }
+}
+
+TEST(BitReaderTest, LeadingOnes) {
+    EXPECT_EQ(spacker::count_leading_ones(0), 0);
+    EXPECT_EQ(spacker::count_leading_ones(-1), 64);
+    EXPECT_EQ(spacker::count_leading_ones(static_cast<uint64_t>(0b1110) << 60), 3);
+}
+
+template<bool rle, class Scheme, typename T>
+void compare(const std::vector<T>& input) {
+    auto packed = spacker::pack_psip<rle, Scheme>(input.size(), input.data());
+    std::vector<T> unpacked(input.size());
+    spacker::unpack_psip_wide<Scheme>(packed.size(), packed.data(), unpacked.size(), unpacked.data());
+    EXPECT_EQ(input, unpacked);
+
+    std::vector<T> reference(input.size());
+    spacker::unpack_psip<Scheme>(packed.size(), packed.data(), reference.size(), reference.data());
+    EXPECT_EQ(reference, unpacked);
+}
+
+TEST(UnpackWideTest, Doubling) {
+    for (int shift = 1; shift < 8; ++shift) {
+        auto output = mixed_randomize<uint8_t>(1000, shift);
+        compare<false, spacker::Doubling<> >(output);
+        compare<true, spacker::Doubling<> >(output);
+    }
+
+    auto output = mixed_randomize<uint16_t>(1000, 15);
+    compare<false, spacker::Doubling<> >(output);
+    compare<true, spacker::Doubling<> >(output);
+
+    auto output32 = mixed_randomize<uint32_t>(1000, 31);
+    compare<false, spacker::Doubling<> >(output32);
+    compare<true, spacker::Doubling<> >(output32);
+    compare<true, spacker::Doubling<2> >(output32);
+
+    // Checking that we handle payloads that are wider than the window.
+    auto output64 = mixed_randomize<uint64_t>(1000, 63);
+    compare<false, spacker::Doubling<> >(output64);
+    compare<true, spacker::Doubling<> >(output64);
+}
+
+TEST(UnpackWideTest, Multiplier) {
+    auto output = mixed_randomize<uint16_t>(1000, 15);
+    compare<false, spacker::Multiplier<> >(output);
+    compare<true, spacker::Multiplier<> >(output);
+
+    auto output32 = mixed_randomize<uint32_t>(1000, 23);
+    compare<false, spacker::Multiplier<> >(output32);
+    compare<true, spacker::Multiplier<> >(output32);
+    compare<true, spacker::Multiplier<8> >(output32);
+}
+
+TEST(UnpackWideTest, LongRuns) {
+    std::vector<uint32_t> input(1000, 5);
+    input.insert(input.end(), 20, 1000);
+    input.insert(input.end(), 100000, 1);
+    input.push_back(2);
+    compare<true, spacker::Doubling<> >(input);
+    compare<true, spacker::Multiplier<> >(input);
+}